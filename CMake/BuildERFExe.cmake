@@ -30,6 +30,10 @@ function(build_erf_lib erf_lib_name)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_WARM_NO_PRECIP)
   endif()
 
+  if(ERF_ENABLE_MIXED_PRECISION)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_MIXED_PRECISION)
+  endif()
+
   if(ERF_ENABLE_POISSON_SOLVE)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/Utils/ERF_PoissonSolve.cpp)
@@ -57,6 +61,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Microphysics/IceFall.cpp
        ${SRC_DIR}/Microphysics/Precip.cpp
        ${SRC_DIR}/Microphysics/PrecipFall.cpp
+       ${SRC_DIR}/Microphysics/ColumnProc.cpp
        ${SRC_DIR}/Microphysics/Diagnose.cpp
        ${SRC_DIR}/Microphysics/Update.cpp)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_MOISTURE)
@@ -113,6 +118,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/TimeIntegration/ERF_make_condensation_source.cpp
        ${SRC_DIR}/TimeIntegration/ERF_make_fast_coeffs.cpp
        ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_pre.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_fused.cpp
        ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_post.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_N.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_T.cpp
@@ -0,0 +1,129 @@
+//
+// Micro-benchmark for the tabulated saturation vapor pressures.
+//
+// We evaluate qsatw, qsati, dtqsatw and dtqsati at sattable.npts random temperatures
+// and pressures, first with the analytic forms (erf_qsatw etc.) and then with a
+// SaturationTable built for each (sattable.order, sattable.tol) pair, and report the
+// time per evaluation of all four, the speedup, and the max relative difference.
+//
+#include <AMReX.H>
+#include <AMReX_Gpu.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+
+#include <iomanip>
+#include <limits>
+
+#include <ERF_SaturationTable.H>
+
+using namespace amrex;
+
+namespace {
+
+constexpr int nfunc = 4;
+
+void eval_analytic (int npts, const Real* t, const Real* p, Real* q)
+{
+    ParallelFor(npts, [=] AMREX_GPU_DEVICE (int n) noexcept
+    {
+        erf_qsatw  (t[n], p[n], q[n           ]);
+        erf_qsati  (t[n], p[n], q[n +   npts]);
+        erf_dtqsatw(t[n], p[n], q[n + 2*npts]);
+        erf_dtqsati(t[n], p[n], q[n + 3*npts]);
+    });
+}
+
+void eval_table (const SaturationLookup& sat, int npts, const Real* t, const Real* p, Real* q)
+{
+    ParallelFor(npts, [=] AMREX_GPU_DEVICE (int n) noexcept
+    {
+        sat.qsatw  (t[n], p[n], q[n           ]);
+        sat.qsati  (t[n], p[n], q[n +   npts]);
+        sat.dtqsatw(t[n], p[n], q[n + 2*npts]);
+        sat.dtqsati(t[n], p[n], q[n + 3*npts]);
+    });
+}
+
+Real max_rel_diff (int npts, const Real* q_ref, const Real* q)
+{
+    return Reduce::Max<Real>(nfunc*npts, [=] AMREX_GPU_DEVICE (int n) noexcept -> Real
+    {
+        return std::abs(q[n] - q_ref[n]) / std::max(std::abs(q_ref[n]), std::numeric_limits<Real>::min());
+    });
+}
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int npts = 1 << 22;
+        int nrep = 20;
+        Vector<int>  order_list{1, 3};
+        Vector<Real> tol_list{1.e-6, 1.e-6};
+
+        ParmParse pp("sattable");
+        pp.query("npts", npts);
+        pp.query("nrep", nrep);
+        pp.queryarr("order", order_list);
+        pp.queryarr("tol", tol_list);
+        AMREX_ALWAYS_ASSERT(order_list.size() == tol_list.size());
+
+        // Temperatures from 160 K to 340 K and pressures from 100 mb to 1050 mb
+        Gpu::DeviceVector<Real> t_d(npts);
+        Gpu::DeviceVector<Real> p_d(npts);
+        Gpu::DeviceVector<Real> q_ref(nfunc*npts);
+        Gpu::DeviceVector<Real> q_tab(nfunc*npts);
+        Real* t = t_d.data();
+        Real* p = p_d.data();
+        ParallelForRNG(npts, [=] AMREX_GPU_DEVICE (int n, RandomEngine const& engine) noexcept
+        {
+            t[n] = 160.0 + 180.0 * Random(engine);
+            p[n] = 100.0 + 950.0 * Random(engine);
+        });
+
+        // Warm up before timing
+        eval_analytic(npts, t, p, q_ref.data());
+        Gpu::streamSynchronize();
+
+        Real t0 = amrex::second();
+        for (int n = 0; n < nrep; ++n) {
+            eval_analytic(npts, t, p, q_ref.data());
+        }
+        Gpu::streamSynchronize();
+        Real t_analytic = (amrex::second() - t0) / (Real(nrep) * npts);
+
+        amrex::Print() << "analytic: " << t_analytic << " s per point" << std::endl;
+        amrex::Print() << " order       tol   intervals      bytes    table (s/pt)"
+                       << "     speedup   max rel diff" << std::endl;
+
+        for (int m = 0; m < order_list.size(); ++m)
+        {
+            SaturationTable table;
+            table.define(order_list[m], tol_list[m]);
+            const SaturationLookup sat = table.view();
+
+            eval_table(sat, npts, t, p, q_tab.data());
+            Gpu::streamSynchronize();
+
+            t0 = amrex::second();
+            for (int n = 0; n < nrep; ++n) {
+                eval_table(sat, npts, t, p, q_tab.data());
+            }
+            Gpu::streamSynchronize();
+            Real t_table = (amrex::second() - t0) / (Real(nrep) * npts);
+
+            Real diff = max_rel_diff(npts, q_ref.data(), q_tab.data());
+
+            amrex::Print() << std::setw(6)  << order_list[m]
+                           << std::setw(10) << tol_list[m]
+                           << std::setw(12) << table.intervals()
+                           << std::setw(11) << table.bytes()
+                           << std::setw(16) << t_table
+                           << std::setw(12) << t_analytic / t_table
+                           << std::setw(15) << diff << std::endl;
+        }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,193 @@
+//
+// Micro-benchmark for the vertical tridiagonal solve of the acoustic substep.
+//
+// For each number of vertical levels in tridiag.nz we build a set of diagonally
+// dominant systems, factor them the way make_fast_coeffs does, and then time
+//   (1) the loop nest that was used in erf_fast_rhs_N/T/MT (separate Array4s for A, 1/B, C)
+//   (2) VerticalTridiagSolver (packed, blocked in i)
+// and report the time per solve and the max difference between the two answers.
+//
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+
+#include <iomanip>
+
+#include <ERF_VerticalTridiagSolver.H>
+
+using namespace amrex;
+
+namespace {
+
+void factor (MultiFab& coeffs)
+{
+    for (MFIter mfi(coeffs); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        auto const& a = coeffs.array(mfi);
+        ParallelForRNG(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k, RandomEngine const& engine) noexcept
+        {
+            a(i,j,k,0) = -0.1 * Random(engine);
+            a(i,j,k,1) =  1.0 + Random(engine);
+            a(i,j,k,2) = -0.1 * Random(engine);
+        });
+
+        Box b2d = bx;
+        b2d.setRange(2,0);
+        const int klo = bx.smallEnd(2);
+        const int khi = bx.bigEnd(2);
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+        {
+            a(i,j,klo,0) = 0.0; a(i,j,klo,1) = 1.0; a(i,j,klo,2) = 0.0;
+            a(i,j,khi,0) = 0.0; a(i,j,khi,1) = 1.0; a(i,j,khi,2) = 0.0;
+
+            Real bet = a(i,j,klo,1);
+            for (int k = klo+1; k <= khi; k++) {
+                Real gam = a(i,j,k-1,2) / bet;
+                bet = a(i,j,k,1) - a(i,j,k,0)*gam;
+                a(i,j,k,1) = bet;
+            }
+            for (int k = klo; k <= khi; k++) {
+                a(i,j,k,1) = 1.0 / a(i,j,k,1);
+            }
+        });
+    }
+}
+
+void solve_reference (const MultiFab& coeffs, const MultiFab& rhs, MultiFab& soln)
+{
+    for (MFIter mfi(soln); mfi.isValid(); ++mfi)
+    {
+        Box bx = enclosedCells(mfi.validbox());
+
+        auto const&     coeffA_a = coeffs.const_array(mfi,0);
+        auto const& inv_coeffB_a = coeffs.const_array(mfi,1);
+        auto const&     coeffC_a = coeffs.const_array(mfi,2);
+        auto const&        RHS_a = rhs.const_array(mfi);
+        auto const&       soln_a = soln.array(mfi);
+
+        auto const lo = amrex::lbound(bx);
+        auto const hi = amrex::ubound(bx);
+#ifdef AMREX_USE_GPU
+        Box b2d = bx;
+        b2d.setRange(2,0);
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
+            soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
+            for (int k = lo.z+1; k <= hi.z+1; k++) {
+                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
+            }
+            for (int k = hi.z; k >= lo.z; k--) {
+                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
+            }
+        });
+#else
+        for (int j = lo.y; j <= hi.y; ++j) {
+            AMREX_PRAGMA_SIMD
+            for (int i = lo.x; i <= hi.x; ++i) {
+                soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
+            }
+        }
+        for (int k = lo.z+1; k <= hi.z+1; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
+                }
+            }
+        }
+        for (int k = hi.z; k >= lo.z; --k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
+                }
+            }
+        }
+#endif
+    }
+}
+
+void solve_packed (const VerticalTridiagSolver& solver, const MultiFab& rhs, MultiFab& soln)
+{
+    for (MFIter mfi(soln); mfi.isValid(); ++mfi)
+    {
+        Box bx = enclosedCells(mfi.validbox());
+        solver.solve(mfi, bx, rhs.const_array(mfi), soln.array(mfi));
+    }
+}
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nx = 64;
+        int ny = 64;
+        int nrep = 20;
+        Vector<int> nz_list{64, 128, 256};
+
+        ParmParse pp("tridiag");
+        pp.query("nx", nx);
+        pp.query("ny", ny);
+        pp.query("nrep", nrep);
+        pp.queryarr("nz", nz_list);
+
+        amrex::Print() << "    nz     reference (s)     packed (s)     speedup     max |diff|" << std::endl;
+
+        for (int nz : nz_list)
+        {
+            // One box so both versions see exactly the same columns
+            Box domain(IntVect(0,0,0), IntVect(nx-1,ny-1,nz-1));
+            BoxArray ba_z(surroundingNodes(domain,2));
+            DistributionMapping dm(ba_z);
+
+            MultiFab coeffs(ba_z, dm, 3, 0);
+            MultiFab rhs   (ba_z, dm, 1, 0);
+            MultiFab soln_r(ba_z, dm, 1, 0);
+            MultiFab soln_p(ba_z, dm, 1, 0);
+
+            factor(coeffs);
+            FillRandom(rhs, 0, 1);
+
+            VerticalTridiagSolver solver;
+            solver.define(ba_z, dm);
+            solver.pack(coeffs, BoxArray(domain));
+
+            // Warm up both versions before timing
+            solve_reference(coeffs, rhs, soln_r);
+            solve_packed(solver, rhs, soln_p);
+            Gpu::streamSynchronize();
+
+            Real t0 = amrex::second();
+            for (int n = 0; n < nrep; ++n) {
+                solve_reference(coeffs, rhs, soln_r);
+            }
+            Gpu::streamSynchronize();
+            Real t_ref = (amrex::second() - t0) / nrep;
+
+            t0 = amrex::second();
+            for (int n = 0; n < nrep; ++n) {
+                solve_packed(solver, rhs, soln_p);
+            }
+            Gpu::streamSynchronize();
+            Real t_packed = (amrex::second() - t0) / nrep;
+
+            ParallelDescriptor::ReduceRealMax(t_ref);
+            ParallelDescriptor::ReduceRealMax(t_packed);
+
+            MultiFab::Subtract(soln_p, soln_r, 0, 0, 1, 0);
+            Real max_diff = soln_p.norm0();
+
+            amrex::Print() << std::setw(6)  << nz
+                           << std::setw(18) << t_ref
+                           << std::setw(15) << t_packed
+                           << std::setw(12) << t_ref / t_packed
+                           << std::setw(15) << max_diff << std::endl;
+        }
+    }
+    amrex::Finalize();
+}
@@ -1,8 +1,122 @@
 #include <AdvectionSrcForMom_N.H>
 #include <AdvectionSrcForMom_T.H>
+#include <AdvectionSpatialOrder.H>
 
 using namespace amrex;
 
+// **************************************************************************************
+// Kernels for spatial order > 2; these are instantiated for each combination of
+// horizontal and vertical order (or each WENO order) so the stencils are fixed at
+// compile time.  AdvectionSrcForMom picks the instantiation once per call.
+// **************************************************************************************
+template <int horiz_spatial_order, int vert_spatial_order>
+void
+AdvectionSrcForMomCentered (const Box& bxx, const Box& bxy, const Box& bxz,
+                            const Array4<      Real>& rho_u_rhs, const Array4<      Real>& rho_v_rhs,
+                            const Array4<      Real>& rho_w_rhs,
+                            const Array4<const Real>& u        , const Array4<const Real>& v,
+                            const Array4<const Real>& w        ,
+                            const Array4<const Real>& rho_u    , const Array4<const Real>& rho_v,
+                            const Array4<const Real>& Omega    ,
+                            const Array4<const Real>& z_nd     , const Array4<const Real>& detJ,
+                            const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                            const Array4<const Real>& mf_m,
+                            const Array4<const Real>& mf_u,
+                            const Array4<const Real>& mf_v,
+                            const int domhi_z,
+                            const int use_terrain)
+{
+    if (use_terrain) {
+        amrex::ParallelFor(bxx, bxy, bxz,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_T<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, u, z_nd, detJ, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_T<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, v, z_nd, detJ, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_T<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, w, z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, domhi_z);
+        });
+    } else {
+        amrex::ParallelFor(bxx, bxy, bxz,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_N<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, u, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_N<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, v, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_N<horiz_spatial_order,vert_spatial_order>(
+                                     i, j, k, rho_u, rho_v, Omega, w, cellSizeInv, mf_m, mf_u, mf_v, domhi_z);
+        });
+    }
+}
+
+template <int spatial_order_WENO>
+void
+AdvectionSrcForMomWENO (const Box& bxx, const Box& bxy, const Box& bxz,
+                        const Array4<      Real>& rho_u_rhs, const Array4<      Real>& rho_v_rhs,
+                        const Array4<      Real>& rho_w_rhs,
+                        const Array4<const Real>& u        , const Array4<const Real>& v,
+                        const Array4<const Real>& w        ,
+                        const Array4<const Real>& rho_u    , const Array4<const Real>& rho_v,
+                        const Array4<const Real>& Omega    ,
+                        const Array4<const Real>& z_nd     , const Array4<const Real>& detJ,
+                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                        const Array4<const Real>& mf_m,
+                        const Array4<const Real>& mf_u,
+                        const Array4<const Real>& mf_v,
+                        const int domhi_z,
+                        const int use_terrain)
+{
+    if (use_terrain) {
+        amrex::ParallelFor(bxx, bxy, bxz,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_WENO_T<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, u, z_nd, detJ, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_WENO_T<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, v, z_nd, detJ, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_WENO_T<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, w, z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, domhi_z);
+        });
+    } else {
+        amrex::ParallelFor(bxx, bxy, bxz,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_WENO_N<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, u, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_WENO_N<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, v, cellSizeInv, mf_u, mf_v);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_WENO_N<spatial_order_WENO>(
+                                     i, j, k, rho_u, rho_v, Omega, w, cellSizeInv, mf_m, mf_u, mf_v, domhi_z);
+        });
+    }
+}
+
 void
 AdvectionSrcForMom (const Box& bxx, const Box& bxy, const Box& bxz,
                     const Array4<      Real>& rho_u_rhs, const Array4<      Real>& rho_v_rhs,
@@ -196,79 +310,22 @@ AdvectionSrcForMom (const Box& bxx, const Box& bxy, const Box& bxz,
             rho_w_rhs(i, j, k) = -advectionSrc;
         });
 
-    } else if (use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) > 2) && !all_use_WENO) {
+    } else if (!all_use_WENO) {
 
-        amrex::ParallelFor(bxx, bxy, bxz,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_T(i, j, k, rho_u, rho_v, Omega, u, z_nd, detJ,
-                                                        cellSizeInv, mf_u, mf_v, horiz_spatial_order, vert_spatial_order);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_T(i, j, k, rho_u, rho_v, Omega, v, z_nd, detJ,
-                                                        cellSizeInv, mf_u, mf_v, horiz_spatial_order, vert_spatial_order);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_T(i, j, k, rho_u, rho_v, Omega, w, z_nd, detJ,
-                                                        cellSizeInv, mf_m, mf_u, mf_v, horiz_spatial_order, vert_spatial_order, domhi_z);
-        });
-
-    } else if (!use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) > 2) && !all_use_WENO) {
-
-        amrex::ParallelFor(bxx, bxy, bxz,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_N(i, j, k, rho_u, rho_v, Omega, u,
-                                                        cellSizeInv, mf_u, mf_v, horiz_spatial_order, vert_spatial_order);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_N(i, j, k, rho_u, rho_v, Omega, v,
-                                                        cellSizeInv, mf_u, mf_v, horiz_spatial_order, vert_spatial_order);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_N(i, j, k, rho_u, rho_v, Omega, w,
-                                                        cellSizeInv, mf_m, mf_u, mf_v, horiz_spatial_order, vert_spatial_order, domhi_z);
+        DispatchSpatialOrder(horiz_spatial_order, [&] (auto horiz_order) {
+        DispatchSpatialOrder(vert_spatial_order , [&] (auto vert_order) {
+            AdvectionSrcForMomCentered<decltype(horiz_order)::value, decltype(vert_order)::value>(
+                                bxx, bxy, bxz, rho_u_rhs, rho_v_rhs, rho_w_rhs, u, v, w, rho_u, rho_v, Omega,
+                                z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, domhi_z, use_terrain);
         });
-    } else if (use_terrain) {
-
-        amrex::ParallelFor(bxx, bxy, bxz,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_WENO_T(i, j, k, rho_u, rho_v, Omega, u, z_nd, detJ,
-                                                             cellSizeInv, mf_u, mf_v, spatial_order_WENO);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_WENO_T(i, j, k, rho_u, rho_v, Omega, v, z_nd, detJ,
-                                                             cellSizeInv, mf_u, mf_v, spatial_order_WENO);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_WENO_T(i, j, k, rho_u, rho_v, Omega, w, z_nd, detJ,
-                                                             cellSizeInv, mf_m, mf_u, mf_v, spatial_order_WENO, domhi_z);
         });
 
     } else {
 
-        amrex::ParallelFor(bxx, bxy, bxz,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_u_rhs(i, j, k) = -AdvectionSrcForXMom_WENO_N(i, j, k, rho_u, rho_v, Omega, u,
-                                                             cellSizeInv, mf_u, mf_v, spatial_order_WENO);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_v_rhs(i, j, k) = -AdvectionSrcForYMom_WENO_N(i, j, k, rho_u, rho_v, Omega, v,
-                                                             cellSizeInv, mf_u, mf_v, spatial_order_WENO);
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            rho_w_rhs(i, j, k) = -AdvectionSrcForZMom_WENO_N(i, j, k, rho_u, rho_v, Omega, w,
-                                                             cellSizeInv, mf_m, mf_u, mf_v, spatial_order_WENO, domhi_z);
+        DispatchWENOOrder(spatial_order_WENO, [&] (auto weno_order) {
+            AdvectionSrcForMomWENO<decltype(weno_order)::value>(
+                                bxx, bxy, bxz, rho_u_rhs, rho_v_rhs, rho_w_rhs, u, v, w, rho_u, rho_v, Omega,
+                                z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, domhi_z, use_terrain);
         });
     }
 }
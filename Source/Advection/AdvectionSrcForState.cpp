@@ -3,57 +3,54 @@
 #include <Advection.H>
 #include <Interpolation.H>
 #include <Interpolation_WENO.H>
+#include <AdvectionSpatialOrder.H>
 
 using namespace amrex;
 
+// **************************************************************************************
+// Kernels for spatial order > 2; these are instantiated for each combination of
+// horizontal and vertical order (or each WENO order) so the stencils are fixed at
+// compile time.  The entry points below pick the instantiation once per call.
+// **************************************************************************************
+template <int horiz_spatial_order, int vert_spatial_order>
 void
-AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
-                            const Array4<Real>& advectionSrc,
-                            const Array4<const Real>& rho_u,
-                            const Array4<const Real>& rho_v,
-                            const Array4<const Real>& Omega, Real fac,
-                            const Array4<      Real>& avg_xmom,
-                            const Array4<      Real>& avg_ymom,
-                            const Array4<      Real>& avg_zmom,
-                            const Array4<const Real>& cell_prim,
-                            const Array4<const Real>& z_nd, const Array4<const Real>& detJ,
-                            const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                            const Array4<const Real>& mf_m,
-                            const Array4<const Real>& mf_u,
-                            const Array4<const Real>& mf_v,
-                            const bool all_use_WENO,
-                            const int  spatial_order_WENO,
-                            const int horiz_spatial_order,
-                            const int vert_spatial_order,
-                            const int use_terrain)
+AdvectionSrcForRhoAndThetaCentered (const Box& bx, const Box& valid_bx,
+                                    const Array4<Real>& advectionSrc,
+                                    const Array4<const Real>& rho_u,
+                                    const Array4<const Real>& rho_v,
+                                    const Array4<const Real>& Omega, Real fac,
+                                    const Array4<      Real>& avg_xmom,
+                                    const Array4<      Real>& avg_ymom,
+                                    const Array4<      Real>& avg_zmom,
+                                    const Array4<const Real>& cell_prim,
+                                    const Array4<const Real>& z_nd, const Array4<const Real>& detJ,
+                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                    const Array4<const Real>& mf_m,
+                                    const Array4<const Real>& mf_u,
+                                    const Array4<const Real>& mf_v,
+                                    const int use_terrain)
 {
-    BL_PROFILE_VAR("AdvectionSrcForRhoAndTheta", AdvectionSrcForRhoAndTheta);
     auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
 
     // We note that valid_bx is the actual grid, while bx may be a tile within that grid
     const auto& vbx_hi = amrex::ubound(valid_bx);
 
-    if ( use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
+    if (use_terrain) {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real invdetJ = 1./ detJ(i,j,k);
 
-            Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
-            Real xflux_hi = rho_u(i+1,j,k) / mf_u(i+1,j  ,0);
-            Real yflux_lo = rho_v(i,j  ,k) / mf_v(i  ,j  ,0);
-            Real yflux_hi = rho_v(i,j+1,k) / mf_v(i  ,j+1,0);
             Real zflux_lo = Omega(i,j,k  );
             Real zflux_hi = Omega(i,j,k+1);
 
-            Real met_h_zeta_xlo = Compute_h_zeta_AtIface(i  ,j  ,k,cellSizeInv,z_nd);
-            xflux_lo *= met_h_zeta_xlo;
             Real met_h_zeta_xhi = Compute_h_zeta_AtIface(i+1,j  ,k,cellSizeInv,z_nd);
-            xflux_hi *= met_h_zeta_xhi;
-
-            Real met_h_zeta_ylo = Compute_h_zeta_AtJface(i  ,j  ,k,cellSizeInv,z_nd);
-            yflux_lo *= met_h_zeta_ylo;
+            Real xflux_hi = rho_u(i+1,j  ,k) * met_h_zeta_xhi * 1./mf_u(i  ,j  ,0);
+            Real met_h_zeta_xlo = Compute_h_zeta_AtIface(i  ,j  ,k,cellSizeInv,z_nd);
+            Real xflux_lo = rho_u(i  ,j  ,k) * met_h_zeta_xlo * 1./mf_u(i+1,j  ,0);
             Real met_h_zeta_yhi = Compute_h_zeta_AtJface(i  ,j+1,k,cellSizeInv,z_nd);
-            yflux_hi *= met_h_zeta_yhi;
+            Real yflux_hi = rho_v(i  ,j+1,k) * met_h_zeta_yhi * 1./mf_v(i  ,j  ,0);
+            Real met_h_zeta_ylo = Compute_h_zeta_AtJface(i  ,j  ,k,cellSizeInv,z_nd);
+            Real yflux_lo = rho_v(i  ,j  ,k) * met_h_zeta_ylo * 1./mf_v(i  ,j+1,0);
 
             avg_xmom(i  ,j,k) += fac*xflux_lo;
             if (i == vbx_hi.x)
@@ -65,7 +62,8 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
             if (k == vbx_hi.z)
                 avg_zmom(i,j,k+1) += fac*zflux_hi;
 
-            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+            Real mf   = mf_m(i,j,0);
+            Real mfsq = mf*mf;
 
             advectionSrc(i,j,k,0) = - invdetJ * (
                 ( xflux_hi - xflux_lo ) * dxInv * mfsq +
@@ -73,31 +71,24 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
                 ( zflux_hi - zflux_lo ) * dzInv);
 
             const int prim_index = 0;
-            advectionSrc(i,j,k,1) = - invdetJ * 0.5 * (
-                ( xflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i+1,j,k,prim_index)) -
-                  xflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i-1,j,k,prim_index)) ) * dxInv * mfsq +
-                ( yflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j+1,k,prim_index)) -
-                  yflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j-1,k,prim_index)) ) * dyInv * mfsq +
-                ( zflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k+1,prim_index)) -
-                  zflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k-1,prim_index)) ) * dzInv);
+            advectionSrc(i,j,k,1) = - invdetJ * (
+                ( xflux_hi * InterpolateInX<horiz_spatial_order>(i+1,j  , k  , cell_prim, prim_index, rho_u(i+1,j,k)) -
+                  xflux_lo * InterpolateInX<horiz_spatial_order>(i  ,j  , k  , cell_prim, prim_index, rho_u(i  ,j,k)) ) * dxInv * mfsq +
+                ( yflux_hi * InterpolateInY<horiz_spatial_order>(i  ,j+1, k  , cell_prim, prim_index, rho_v(i,j+1,k)) -
+                  yflux_lo * InterpolateInY<horiz_spatial_order>(i  ,j  , k  , cell_prim, prim_index, rho_v(i  ,j,k)) ) * dyInv * mfsq +
+                ( zflux_hi * InterpolateInZ<vert_spatial_order>(i  ,j  , k+1, cell_prim, prim_index, Omega(i,j,k+1)) -
+                  zflux_lo * InterpolateInZ<vert_spatial_order>(i  ,j  , k  , cell_prim, prim_index, Omega(i  ,j,k)) ) * dzInv);
         });
-    } else if ( use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) > 2) && !all_use_WENO) {
+    } else {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            Real invdetJ = 1./ detJ(i,j,k);
-
+            Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
+            Real xflux_hi = rho_u(i+1,j,k) / mf_u(i+1,j  ,0);
+            Real yflux_lo = rho_v(i,j  ,k) / mf_v(i  ,j  ,0);
+            Real yflux_hi = rho_v(i,j+1,k) / mf_v(i  ,j+1,0);
             Real zflux_lo = Omega(i,j,k  );
             Real zflux_hi = Omega(i,j,k+1);
 
-            Real met_h_zeta_xhi = Compute_h_zeta_AtIface(i+1,j  ,k,cellSizeInv,z_nd);
-            Real xflux_hi = rho_u(i+1,j  ,k) * met_h_zeta_xhi * 1./mf_u(i  ,j  ,0);
-            Real met_h_zeta_xlo = Compute_h_zeta_AtIface(i  ,j  ,k,cellSizeInv,z_nd);
-            Real xflux_lo = rho_u(i  ,j  ,k) * met_h_zeta_xlo * 1./mf_u(i+1,j  ,0);
-            Real met_h_zeta_yhi = Compute_h_zeta_AtJface(i  ,j+1,k,cellSizeInv,z_nd);
-            Real yflux_hi = rho_v(i  ,j+1,k) * met_h_zeta_yhi * 1./mf_v(i  ,j  ,0);
-            Real met_h_zeta_ylo = Compute_h_zeta_AtJface(i  ,j  ,k,cellSizeInv,z_nd);
-            Real yflux_lo = rho_v(i  ,j  ,k) * met_h_zeta_ylo * 1./mf_v(i  ,j+1,0);
-
             avg_xmom(i  ,j,k) += fac*xflux_lo;
             if (i == vbx_hi.x)
                 avg_xmom(i+1,j,k) += fac*xflux_hi;
@@ -106,26 +97,52 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
                 avg_ymom(i,j+1,k) += fac*yflux_hi;
             avg_zmom(i,j,k  ) += fac*zflux_lo;
             if (k == vbx_hi.z)
-                avg_zmom(i,j,k+1) += fac*zflux_hi;
+               avg_zmom(i,j,k+1) += fac*zflux_hi;
 
             Real mf   = mf_m(i,j,0);
             Real mfsq = mf*mf;
 
-            advectionSrc(i,j,k,0) = - invdetJ * (
+            advectionSrc(i,j,k,0) = -(
                 ( xflux_hi - xflux_lo ) * dxInv * mfsq +
                 ( yflux_hi - yflux_lo ) * dyInv * mfsq +
                 ( zflux_hi - zflux_lo ) * dzInv);
 
             const int prim_index = 0;
-            advectionSrc(i,j,k,1) = - invdetJ * (
-                ( xflux_hi * InterpolateInX(i+1,j  , k  , cell_prim, prim_index, rho_u(i+1,j,k), horiz_spatial_order) -
-                  xflux_lo * InterpolateInX(i  ,j  , k  , cell_prim, prim_index, rho_u(i  ,j,k), horiz_spatial_order) ) * dxInv * mfsq +
-                ( yflux_hi * InterpolateInY(i  ,j+1, k  , cell_prim, prim_index, rho_v(i,j+1,k), horiz_spatial_order) -
-                  yflux_lo * InterpolateInY(i  ,j  , k  , cell_prim, prim_index, rho_v(i  ,j,k), horiz_spatial_order) ) * dyInv * mfsq +
-                ( zflux_hi * InterpolateInZ(i  ,j  , k+1, cell_prim, prim_index, Omega(i,j,k+1), vert_spatial_order) -
-                  zflux_lo * InterpolateInZ(i  ,j  , k  , cell_prim, prim_index, Omega(i  ,j,k), vert_spatial_order) ) * dzInv);
+            advectionSrc(i,j,k,1) = -(
+              ( xflux_hi * InterpolateInX<horiz_spatial_order>(i+1,j  , k  , cell_prim, prim_index, rho_u(i+1,j,k)) -
+                xflux_lo * InterpolateInX<horiz_spatial_order>(i  ,j  , k  , cell_prim, prim_index, rho_u(i  ,j,k)) ) * dxInv * mfsq +
+              ( yflux_hi * InterpolateInY<horiz_spatial_order>(i  ,j+1, k  , cell_prim, prim_index, rho_v(i,j+1,k)) -
+                yflux_lo * InterpolateInY<horiz_spatial_order>(i  ,j  , k  , cell_prim, prim_index, rho_v(i  ,j,k)) ) * dyInv * mfsq +
+              ( zflux_hi * InterpolateInZ<vert_spatial_order>(i  ,j  , k+1, cell_prim, prim_index, Omega(i,j,k+1)) -
+                zflux_lo * InterpolateInZ<vert_spatial_order>(i  ,j  , k  , cell_prim, prim_index, Omega(i  ,j,k)) ) * dzInv);
         });
-    } else if (use_terrain) {
+    }
+}
+
+template <int spatial_order_WENO>
+void
+AdvectionSrcForRhoAndThetaWENO (const Box& bx, const Box& valid_bx,
+                                const Array4<Real>& advectionSrc,
+                                const Array4<const Real>& rho_u,
+                                const Array4<const Real>& rho_v,
+                                const Array4<const Real>& Omega, Real fac,
+                                const Array4<      Real>& avg_xmom,
+                                const Array4<      Real>& avg_ymom,
+                                const Array4<      Real>& avg_zmom,
+                                const Array4<const Real>& cell_prim,
+                                const Array4<const Real>& z_nd, const Array4<const Real>& detJ,
+                                const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                const Array4<const Real>& mf_m,
+                                const Array4<const Real>& mf_u,
+                                const Array4<const Real>& mf_v,
+                                const int use_terrain)
+{
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    // We note that valid_bx is the actual grid, while bx may be a tile within that grid
+    const auto& vbx_hi = amrex::ubound(valid_bx);
+
+    if (use_terrain) {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real invdetJ = 1./ detJ(i,j,k);
@@ -162,14 +179,14 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
 
             const int prim_index = 0;
             advectionSrc(i,j,k,1) = - invdetJ * (
-                ( xflux_hi * InterpolateInX_WENO(i+1,j  , k  , cell_prim, prim_index, spatial_order_WENO) -
-                  xflux_lo * InterpolateInX_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dxInv * mfsq +
-                ( yflux_hi * InterpolateInY_WENO(i  ,j+1, k  , cell_prim, prim_index, spatial_order_WENO) -
-                  yflux_lo * InterpolateInY_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dyInv * mfsq +
-                ( zflux_hi * InterpolateInZ_WENO(i  ,j  , k+1, cell_prim, prim_index, spatial_order_WENO) -
-                  zflux_lo * InterpolateInZ_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dzInv);
+                ( xflux_hi * InterpolateInX_WENO<spatial_order_WENO>(i+1,j  , k  , cell_prim, prim_index) -
+                  xflux_lo * InterpolateInX_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dxInv * mfsq +
+                ( yflux_hi * InterpolateInY_WENO<spatial_order_WENO>(i  ,j+1, k  , cell_prim, prim_index) -
+                  yflux_lo * InterpolateInY_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dyInv * mfsq +
+                ( zflux_hi * InterpolateInZ_WENO<spatial_order_WENO>(i  ,j  , k+1, cell_prim, prim_index) -
+                  zflux_lo * InterpolateInZ_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dzInv);
         });
-    } else if ( !use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
+    } else {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
@@ -189,7 +206,8 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
             if (k == vbx_hi.z)
                avg_zmom(i,j,k+1) += fac*zflux_hi;
 
-            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+            Real mf   = mf_m(i,j,0);
+            Real mfsq = mf*mf;
 
             advectionSrc(i,j,k,0) = -(
                 ( xflux_hi - xflux_lo ) * dxInv * mfsq +
@@ -197,17 +215,154 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
                 ( zflux_hi - zflux_lo ) * dzInv);
 
             const int prim_index = 0;
-            advectionSrc(i,j,k,1) = - 0.5 * (
-              ( xflux_hi * (cell_prim(i+1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) -
-                xflux_lo * (cell_prim(i-1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dxInv * mfsq +
-              ( yflux_hi * (cell_prim(i,j+1,k,prim_index) + cell_prim(i,j,k,prim_index)) -
-                yflux_lo * (cell_prim(i,j-1,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dyInv * mfsq +
-              ( zflux_hi * (cell_prim(i,j,k+1,prim_index) + cell_prim(i,j,k,prim_index)) -
-                zflux_lo * (cell_prim(i,j,k-1,prim_index) + cell_prim(i,j,k,prim_index)) ) * dzInv);
+            advectionSrc(i,j,k,1) = -(
+                ( xflux_hi * InterpolateInX_WENO<spatial_order_WENO>(i+1,j  , k  , cell_prim, prim_index) -
+                  xflux_lo * InterpolateInX_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dxInv * mfsq +
+                ( yflux_hi * InterpolateInY_WENO<spatial_order_WENO>(i  ,j+1, k  , cell_prim, prim_index) -
+                  yflux_lo * InterpolateInY_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dyInv * mfsq +
+                ( zflux_hi * InterpolateInZ_WENO<spatial_order_WENO>(i  ,j  , k+1, cell_prim, prim_index) -
+                  zflux_lo * InterpolateInZ_WENO<spatial_order_WENO>(i  ,j  , k  , cell_prim, prim_index) ) * dzInv);
         });
-    } else if ( !use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) > 2) && !all_use_WENO) {
+    }
+}
+
+template <int horiz_spatial_order, int vert_spatial_order>
+void
+AdvectionSrcForScalarsCentered (const Box& bx, const int icomp, const int ncomp, const int comp_block,
+                                const Array4<const Real>& avg_xmom, const Array4<const Real>& avg_ymom,
+                                const Array4<const Real>& avg_zmom,
+                                const Array4<const Real>& cell_prim,
+                                const Array4<Real>& advectionSrc,
+                                const Array4<const Real>& detJ,
+                                const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                const Array4<const Real>& mf_m,
+                                const int use_terrain)
+{
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    const int nblk = (ncomp + comp_block - 1) / comp_block;
+
+    amrex::ParallelFor(bx, nblk, [=] AMREX_GPU_DEVICE (int i, int j, int k, int nb) noexcept
+    {
+        // The face fluxes and metric terms are the same for every component
+        Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
+
+        // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
+        //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
+
+        Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+        const Real xflux_lo = avg_xmom(i  ,j,k);
+        const Real xflux_hi = avg_xmom(i+1,j,k);
+        const Real yflux_lo = avg_ymom(i,j  ,k);
+        const Real yflux_hi = avg_ymom(i,j+1,k);
+        const Real zflux_lo = avg_zmom(i,j,k  );
+        const Real zflux_hi = avg_zmom(i,j,k+1);
+
+        const int n_lo = nb * comp_block;
+        const int n_hi = amrex::min(n_lo + comp_block, ncomp);
+
+        for (int n = n_lo; n < n_hi; ++n)
+        {
+            const int cons_index = icomp + n;
+            const int prim_index = cons_index - 1;
+
+            advectionSrc(i,j,k,cons_index) = - invdetJ * (
+            ( xflux_hi * InterpolateInX<horiz_spatial_order>(i+1,j,k,cell_prim, prim_index, xflux_hi) -
+              xflux_lo * InterpolateInX<horiz_spatial_order>(i  ,j,k,cell_prim, prim_index, xflux_lo) ) * dxInv * mfsq +
+            ( yflux_hi * InterpolateInY<horiz_spatial_order>(i,j+1,k,cell_prim, prim_index, yflux_hi) -
+              yflux_lo * InterpolateInY<horiz_spatial_order>(i,j  ,k,cell_prim, prim_index, yflux_lo) ) * dyInv * mfsq +
+            ( zflux_hi * InterpolateInZ<vert_spatial_order>(i,j,k+1,cell_prim, prim_index, zflux_hi) -
+              zflux_lo * InterpolateInZ<vert_spatial_order>(i,j,k  ,cell_prim, prim_index, zflux_lo) ) * dzInv );
+        }
+    });
+}
+
+template <int spatial_order_WENO>
+void
+AdvectionSrcForScalarsWENO (const Box& bx, const int icomp, const int ncomp, const int comp_block,
+                            const Array4<const Real>& avg_xmom, const Array4<const Real>& avg_ymom,
+                            const Array4<const Real>& avg_zmom,
+                            const Array4<const Real>& cell_prim,
+                            const Array4<Real>& advectionSrc,
+                            const Array4<const Real>& detJ,
+                            const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                            const Array4<const Real>& mf_m,
+                            const int use_terrain)
+{
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    const int nblk = (ncomp + comp_block - 1) / comp_block;
+
+    amrex::ParallelFor(bx, nblk, [=] AMREX_GPU_DEVICE (int i, int j, int k, int nb) noexcept
+    {
+        // The face fluxes and metric terms are the same for every component
+        Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
+
+        // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
+        //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
+
+        Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+        const Real xflux_lo = avg_xmom(i  ,j,k);
+        const Real xflux_hi = avg_xmom(i+1,j,k);
+        const Real yflux_lo = avg_ymom(i,j  ,k);
+        const Real yflux_hi = avg_ymom(i,j+1,k);
+        const Real zflux_lo = avg_zmom(i,j,k  );
+        const Real zflux_hi = avg_zmom(i,j,k+1);
+
+        const int n_lo = nb * comp_block;
+        const int n_hi = amrex::min(n_lo + comp_block, ncomp);
+
+        for (int n = n_lo; n < n_hi; ++n)
+        {
+            const int cons_index = icomp + n;
+            const int prim_index = cons_index - 1;
+
+            advectionSrc(i,j,k,cons_index) = - invdetJ * (
+            ( xflux_hi * InterpolateInX_WENO<spatial_order_WENO>(i+1,j,k,cell_prim, prim_index) -
+              xflux_lo * InterpolateInX_WENO<spatial_order_WENO>(i  ,j,k,cell_prim, prim_index) ) * dxInv * mfsq +
+            ( yflux_hi * InterpolateInY_WENO<spatial_order_WENO>(i,j+1,k,cell_prim, prim_index) -
+              yflux_lo * InterpolateInY_WENO<spatial_order_WENO>(i,j  ,k,cell_prim, prim_index) ) * dyInv * mfsq +
+            ( zflux_hi * InterpolateInZ_WENO<spatial_order_WENO>(i,j,k+1,cell_prim, prim_index) -
+              zflux_lo * InterpolateInZ_WENO<spatial_order_WENO>(i,j,k  ,cell_prim, prim_index) ) * dzInv );
+        }
+    });
+}
+
+
+void
+AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
+                            const Array4<Real>& advectionSrc,
+                            const Array4<const Real>& rho_u,
+                            const Array4<const Real>& rho_v,
+                            const Array4<const Real>& Omega, Real fac,
+                            const Array4<      Real>& avg_xmom,
+                            const Array4<      Real>& avg_ymom,
+                            const Array4<      Real>& avg_zmom,
+                            const Array4<const Real>& cell_prim,
+                            const Array4<const Real>& z_nd, const Array4<const Real>& detJ,
+                            const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                            const Array4<const Real>& mf_m,
+                            const Array4<const Real>& mf_u,
+                            const Array4<const Real>& mf_v,
+                            const bool all_use_WENO,
+                            const int  spatial_order_WENO,
+                            const int horiz_spatial_order,
+                            const int vert_spatial_order,
+                            const int use_terrain)
+{
+    BL_PROFILE_VAR("AdvectionSrcForRhoAndTheta", AdvectionSrcForRhoAndTheta);
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    // We note that valid_bx is the actual grid, while bx may be a tile within that grid
+    const auto& vbx_hi = amrex::ubound(valid_bx);
+
+    if ( use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
+            Real invdetJ = 1./ detJ(i,j,k);
+
             Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
             Real xflux_hi = rho_u(i+1,j,k) / mf_u(i+1,j  ,0);
             Real yflux_lo = rho_v(i,j  ,k) / mf_v(i  ,j  ,0);
@@ -215,6 +370,16 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
             Real zflux_lo = Omega(i,j,k  );
             Real zflux_hi = Omega(i,j,k+1);
 
+            Real met_h_zeta_xlo = Compute_h_zeta_AtIface(i  ,j  ,k,cellSizeInv,z_nd);
+            xflux_lo *= met_h_zeta_xlo;
+            Real met_h_zeta_xhi = Compute_h_zeta_AtIface(i+1,j  ,k,cellSizeInv,z_nd);
+            xflux_hi *= met_h_zeta_xhi;
+
+            Real met_h_zeta_ylo = Compute_h_zeta_AtJface(i  ,j  ,k,cellSizeInv,z_nd);
+            yflux_lo *= met_h_zeta_ylo;
+            Real met_h_zeta_yhi = Compute_h_zeta_AtJface(i  ,j+1,k,cellSizeInv,z_nd);
+            yflux_hi *= met_h_zeta_yhi;
+
             avg_xmom(i  ,j,k) += fac*xflux_lo;
             if (i == vbx_hi.x)
                 avg_xmom(i+1,j,k) += fac*xflux_hi;
@@ -223,26 +388,25 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
                 avg_ymom(i,j+1,k) += fac*yflux_hi;
             avg_zmom(i,j,k  ) += fac*zflux_lo;
             if (k == vbx_hi.z)
-               avg_zmom(i,j,k+1) += fac*zflux_hi;
+                avg_zmom(i,j,k+1) += fac*zflux_hi;
 
-            Real mf   = mf_m(i,j,0);
-            Real mfsq = mf*mf;
+            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
 
-            advectionSrc(i,j,k,0) = -(
+            advectionSrc(i,j,k,0) = - invdetJ * (
                 ( xflux_hi - xflux_lo ) * dxInv * mfsq +
                 ( yflux_hi - yflux_lo ) * dyInv * mfsq +
                 ( zflux_hi - zflux_lo ) * dzInv);
 
             const int prim_index = 0;
-            advectionSrc(i,j,k,1) = -(
-              ( xflux_hi * InterpolateInX(i+1,j  , k  , cell_prim, prim_index, rho_u(i+1,j,k), horiz_spatial_order) -
-                xflux_lo * InterpolateInX(i  ,j  , k  , cell_prim, prim_index, rho_u(i  ,j,k), horiz_spatial_order) ) * dxInv * mfsq +
-              ( yflux_hi * InterpolateInY(i  ,j+1, k  , cell_prim, prim_index, rho_v(i,j+1,k), horiz_spatial_order) -
-                yflux_lo * InterpolateInY(i  ,j  , k  , cell_prim, prim_index, rho_v(i  ,j,k), horiz_spatial_order) ) * dyInv * mfsq +
-              ( zflux_hi * InterpolateInZ(i  ,j  , k+1, cell_prim, prim_index, Omega(i,j,k+1), vert_spatial_order) -
-                zflux_lo * InterpolateInZ(i  ,j  , k  , cell_prim, prim_index, Omega(i  ,j,k), vert_spatial_order) ) * dzInv);
+            advectionSrc(i,j,k,1) = - invdetJ * 0.5 * (
+                ( xflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i+1,j,k,prim_index)) -
+                  xflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i-1,j,k,prim_index)) ) * dxInv * mfsq +
+                ( yflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j+1,k,prim_index)) -
+                  yflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j-1,k,prim_index)) ) * dyInv * mfsq +
+                ( zflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k+1,prim_index)) -
+                  zflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k-1,prim_index)) ) * dzInv);
         });
-    } else {
+    } else if ( !use_terrain && (std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
@@ -262,8 +426,7 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
             if (k == vbx_hi.z)
                avg_zmom(i,j,k+1) += fac*zflux_hi;
 
-            Real mf   = mf_m(i,j,0);
-            Real mfsq = mf*mf;
+            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
 
             advectionSrc(i,j,k,0) = -(
                 ( xflux_hi - xflux_lo ) * dxInv * mfsq +
@@ -271,13 +434,27 @@ AdvectionSrcForRhoAndTheta (const Box& bx, const Box& valid_bx,
                 ( zflux_hi - zflux_lo ) * dzInv);
 
             const int prim_index = 0;
-            advectionSrc(i,j,k,1) = -(
-                ( xflux_hi * InterpolateInX_WENO(i+1,j  , k  , cell_prim, prim_index, spatial_order_WENO) -
-                  xflux_lo * InterpolateInX_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dxInv * mfsq +
-                ( yflux_hi * InterpolateInY_WENO(i  ,j+1, k  , cell_prim, prim_index, spatial_order_WENO) -
-                  yflux_lo * InterpolateInY_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dyInv * mfsq +
-                ( zflux_hi * InterpolateInZ_WENO(i  ,j  , k+1, cell_prim, prim_index, spatial_order_WENO) -
-                  zflux_lo * InterpolateInZ_WENO(i  ,j  , k  , cell_prim, prim_index, spatial_order_WENO) ) * dzInv);
+            advectionSrc(i,j,k,1) = - 0.5 * (
+              ( xflux_hi * (cell_prim(i+1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) -
+                xflux_lo * (cell_prim(i-1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dxInv * mfsq +
+              ( yflux_hi * (cell_prim(i,j+1,k,prim_index) + cell_prim(i,j,k,prim_index)) -
+                yflux_lo * (cell_prim(i,j-1,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dyInv * mfsq +
+              ( zflux_hi * (cell_prim(i,j,k+1,prim_index) + cell_prim(i,j,k,prim_index)) -
+                zflux_lo * (cell_prim(i,j,k-1,prim_index) + cell_prim(i,j,k,prim_index)) ) * dzInv);
+        });
+    } else if (!all_use_WENO) {
+        DispatchSpatialOrder(horiz_spatial_order, [&] (auto horiz_order) {
+        DispatchSpatialOrder(vert_spatial_order , [&] (auto vert_order) {
+            AdvectionSrcForRhoAndThetaCentered<decltype(horiz_order)::value, decltype(vert_order)::value>(
+                bx, valid_bx, advectionSrc, rho_u, rho_v, Omega, fac, avg_xmom, avg_ymom, avg_zmom,
+                cell_prim, z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, use_terrain);
+        });
+        });
+    } else {
+        DispatchWENOOrder(spatial_order_WENO, [&] (auto weno_order) {
+            AdvectionSrcForRhoAndThetaWENO<decltype(weno_order)::value>(
+                bx, valid_bx, advectionSrc, rho_u, rho_v, Omega, fac, avg_xmom, avg_ymom, avg_zmom,
+                cell_prim, z_nd, detJ, cellSizeInv, mf_m, mf_u, mf_v, use_terrain);
         });
     }
 }
@@ -295,7 +472,8 @@ AdvectionSrcForScalars (const Box& bx, const int &icomp, const int &ncomp,
                         const bool moist_use_WENO,
                         const int  spatial_order_WENO,
                         const int horiz_spatial_order, const int vert_spatial_order,
-                        const int use_terrain)
+                        const int use_terrain,
+                        const int scalar_comp_block)
 {
     BL_PROFILE_VAR("AdvectionSrcForScalars", AdvectionSrcForScalars);
     auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
@@ -311,113 +489,73 @@ AdvectionSrcForScalars (const Box& bx, const int &icomp, const int &ncomp,
     // Running with WENO for moisture but not for other vars
     if(moist_use_WENO && ((icomp+ncomp)==NVAR) ) {
         ncomp_end -= 2;
-        amrex::ParallelFor(bx, 2, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        {
-            Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
-
-            // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
-            //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
-
-            const int cons_index = moist_off + n;
-            const int prim_index = cons_index - 1;
-
-            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
-
-            advectionSrc(i,j,k,cons_index) = - invdetJ * (
-            ( avg_xmom(i+1,j,k) *
-                InterpolateInX_WENO(i+1,j,k,cell_prim, prim_index, spatial_order_WENO) -
-              avg_xmom(i  ,j,k) *
-                InterpolateInX_WENO(i  ,j,k,cell_prim, prim_index, spatial_order_WENO) ) * dxInv * mfsq +
-            ( avg_ymom(i,j+1,k) *
-                InterpolateInY_WENO(i,j+1,k,cell_prim, prim_index, spatial_order_WENO) -
-              avg_ymom(i,j  ,k) *
-                InterpolateInY_WENO(i,j  ,k,cell_prim, prim_index, spatial_order_WENO) ) * dyInv * mfsq +
-            ( avg_zmom(i,j,k+1) *
-                InterpolateInZ_WENO(i,j,k+1,cell_prim, prim_index, spatial_order_WENO) -
-              avg_zmom(i,j,k  ) *
-                InterpolateInZ_WENO(i,j,k  ,cell_prim, prim_index, spatial_order_WENO) ) * dzInv );
+        DispatchWENOOrder(spatial_order_WENO, [&] (auto weno_order) {
+            AdvectionSrcForScalarsWENO<decltype(weno_order)::value>(
+                bx, moist_off, 2, 2, avg_xmom, avg_ymom, avg_zmom, cell_prim, advectionSrc,
+                detJ, cellSizeInv, mf_m, use_terrain);
         });
     }
 
-    if ((std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
-
-        amrex::ParallelFor(bx, ncomp_end, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        {
-            Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
-
-            // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
-            //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
-
-            const int cons_index = icomp + n;
-            const int prim_index = cons_index - 1;
+    if (ncomp_end <= 0) return;
 
-            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+    // Number of components advected by each thread; the face fluxes and metric terms
+    // are loaded once per cell and reused for every component of the block
+    const int comp_block = (scalar_comp_block > 0) ? amrex::min(scalar_comp_block, ncomp_end) : ncomp_end;
 
-            advectionSrc(i,j,k,cons_index) = - 0.5 * invdetJ * (
-              ( avg_xmom(i+1,j,k) * (cell_prim(i,j,k,prim_index) + cell_prim(i+1,j,k,prim_index)) -
-                avg_xmom(i  ,j,k) * (cell_prim(i,j,k,prim_index) + cell_prim(i-1,j,k,prim_index)) ) * dxInv * mfsq +
-              ( avg_ymom(i,j+1,k) * (cell_prim(i,j,k,prim_index) + cell_prim(i,j+1,k,prim_index)) -
-                avg_ymom(i,j  ,k) * (cell_prim(i,j,k,prim_index) + cell_prim(i,j-1,k,prim_index)) ) * dyInv * mfsq +
-              ( avg_zmom(i,j,k+1) * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k+1,prim_index)) -
-                avg_zmom(i,j,k  ) * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k-1,prim_index)) ) * dzInv);
-        });
+    if ((std::max(horiz_spatial_order,vert_spatial_order) == 2) && !all_use_WENO) {
 
-    } else if ((std::max(horiz_spatial_order,vert_spatial_order) > 2) && !all_use_WENO) { // order > 2
+        const int nblk = (ncomp_end + comp_block - 1) / comp_block;
 
-        amrex::ParallelFor(bx, ncomp_end, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        amrex::ParallelFor(bx, nblk, [=] AMREX_GPU_DEVICE (int i, int j, int k, int nb) noexcept
         {
             Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
 
             // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
             //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
 
-            const int cons_index = icomp + n;
-            const int prim_index = cons_index - 1;
-
             Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
 
-            advectionSrc(i,j,k,cons_index) = - invdetJ * (
-            ( avg_xmom(i+1,j,k) *
-                InterpolateInX(i+1,j,k,cell_prim, prim_index, avg_xmom(i+1,j,k), horiz_spatial_order) -
-              avg_xmom(i  ,j,k) *
-                InterpolateInX(i  ,j,k,cell_prim, prim_index, avg_xmom(i  ,j,k), horiz_spatial_order) ) * dxInv * mfsq +
-            ( avg_ymom(i,j+1,k) *
-                InterpolateInY(i,j+1,k,cell_prim, prim_index, avg_ymom(i,j+1,k), horiz_spatial_order) -
-              avg_ymom(i,j  ,k) *
-                InterpolateInY(i,j  ,k,cell_prim, prim_index, avg_ymom(i  ,j,k), horiz_spatial_order) ) * dyInv * mfsq +
-            ( avg_zmom(i,j,k+1) *
-                InterpolateInZ(i,j,k+1,cell_prim, prim_index, avg_zmom(i,j,k+1), vert_spatial_order) -
-              avg_zmom(i,j,k  ) *
-                InterpolateInZ(i,j,k  ,cell_prim, prim_index, avg_zmom(i  ,j,k), vert_spatial_order) ) * dzInv );
+            const Real xflux_lo = avg_xmom(i  ,j,k);
+            const Real xflux_hi = avg_xmom(i+1,j,k);
+            const Real yflux_lo = avg_ymom(i,j  ,k);
+            const Real yflux_hi = avg_ymom(i,j+1,k);
+            const Real zflux_lo = avg_zmom(i,j,k  );
+            const Real zflux_hi = avg_zmom(i,j,k+1);
+
+            const int n_lo = nb * comp_block;
+            const int n_hi = amrex::min(n_lo + comp_block, ncomp_end);
+
+            for (int n = n_lo; n < n_hi; ++n)
+            {
+                const int cons_index = icomp + n;
+                const int prim_index = cons_index - 1;
+
+                advectionSrc(i,j,k,cons_index) = - 0.5 * invdetJ * (
+                  ( xflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i+1,j,k,prim_index)) -
+                    xflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i-1,j,k,prim_index)) ) * dxInv * mfsq +
+                  ( yflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j+1,k,prim_index)) -
+                    yflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j-1,k,prim_index)) ) * dyInv * mfsq +
+                  ( zflux_hi * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k+1,prim_index)) -
+                    zflux_lo * (cell_prim(i,j,k,prim_index) + cell_prim(i,j,k-1,prim_index)) ) * dzInv);
+            }
         });
 
-    } else { // all_use_WENO
-
-        amrex::ParallelFor(bx, ncomp_end, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        {
-            Real invdetJ = (use_terrain) ?  1. / detJ(i,j,k) : 1.;
-
-            // NOTE: we don't need to weight avg_xmom, avg_ymom, avg_zmom with terrain metrics
-            //       because that was done when they were constructed in AdvectionSrcForRhoAndTheta
+    } else if (!all_use_WENO) { // order > 2
 
-            const int cons_index = icomp + n;
-            const int prim_index = cons_index - 1;
+        DispatchSpatialOrder(horiz_spatial_order, [&] (auto horiz_order) {
+        DispatchSpatialOrder(vert_spatial_order , [&] (auto vert_order) {
+            AdvectionSrcForScalarsCentered<decltype(horiz_order)::value, decltype(vert_order)::value>(
+                bx, icomp, ncomp_end, comp_block, avg_xmom, avg_ymom, avg_zmom, cell_prim, advectionSrc,
+                detJ, cellSizeInv, mf_m, use_terrain);
+        });
+        });
 
-            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+    } else { // all_use_WENO
 
-            advectionSrc(i,j,k,cons_index) = - invdetJ * (
-            ( avg_xmom(i+1,j,k) *
-                InterpolateInX_WENO(i+1,j,k,cell_prim, prim_index, spatial_order_WENO) -
-              avg_xmom(i  ,j,k) *
-                InterpolateInX_WENO(i  ,j,k,cell_prim, prim_index, spatial_order_WENO) ) * dxInv * mfsq +
-            ( avg_ymom(i,j+1,k) *
-                InterpolateInY_WENO(i,j+1,k,cell_prim, prim_index, spatial_order_WENO) -
-              avg_ymom(i,j  ,k) *
-                InterpolateInY_WENO(i,j  ,k,cell_prim, prim_index, spatial_order_WENO) ) * dyInv * mfsq +
-            ( avg_zmom(i,j,k+1) *
-                InterpolateInZ_WENO(i,j,k+1,cell_prim, prim_index, spatial_order_WENO) -
-              avg_zmom(i,j,k  ) *
-                InterpolateInZ_WENO(i,j,k  ,cell_prim, prim_index, spatial_order_WENO) ) * dzInv );
+        DispatchWENOOrder(spatial_order_WENO, [&] (auto weno_order) {
+            AdvectionSrcForScalarsWENO<decltype(weno_order)::value>(
+                bx, icomp, ncomp_end, comp_block, avg_xmom, avg_ymom, avg_zmom, cell_prim, advectionSrc,
+                detJ, cellSizeInv, mf_m, use_terrain);
         });
 
     }
@@ -3,6 +3,94 @@
 using namespace amrex;
 
 #ifdef ERF_USE_NETCDF
+//
+// Make sure the wrfbdy time slices that bracket every time in [time, time+dt] are in memory,
+// free the ones before them, and start reading the one after them in the background
+//
+void
+ERF::update_wrfbdy_window (const Real time, const Real dt)
+{
+    if (wrfbdy_ntimes == 0) return;
+
+    BL_PROFILE("ERF::update_wrfbdy_window()");
+
+    Real dT = bdy_time_interval;
+
+    int n_lo = static_cast<int>(time / dT);
+    int n_hi = std::min(static_cast<int>((time + dt) / dT) + 1, wrfbdy_ntimes-1);
+
+    // The slices before wrfbdy_first_slice were freed by an earlier call
+    for (int nt = wrfbdy_first_slice; nt < std::min(n_lo, wrfbdy_ntimes); nt++) {
+        bdy_data_xlo[nt].clear();
+        bdy_data_xhi[nt].clear();
+        bdy_data_ylo[nt].clear();
+        bdy_data_yhi[nt].clear();
+    }
+    wrfbdy_first_slice = std::max(wrfbdy_first_slice, n_lo);
+
+    // Since the window only moves forward, the first slice we load here is the one
+    //    that was read ahead (unless the window has moved past it)
+    for (int nt = n_lo; nt <= n_hi; nt++) {
+        if (bdy_data_xlo[nt].empty()) load_wrfbdy_slice(nt);
+    }
+
+    int n_next = n_hi + 1;
+    if (wrfbdy_prefetch && ParallelDescriptor::IOProcessor() && !wrfbdy_next_slice.valid() &&
+        n_next < wrfbdy_ntimes && bdy_data_xlo[n_next].empty())
+    {
+        wrfbdy_next_slice = std::async(std::launch::async, read_slice_from_wrfbdy, nc_bdy_file, n_next);
+    }
+}
+
+//
+// Read time slice nt of the wrfbdy file (or take it from the read ahead), send each rank the
+// part of each face it needs and convert it to the ERF variables
+//
+void
+ERF::load_wrfbdy_slice (int nt)
+{
+    BL_PROFILE("ERF::load_wrfbdy_slice()");
+
+    const Box& domain = geom[0].Domain();
+
+    WRFBdySlice raw;
+    if (ParallelDescriptor::IOProcessor()) {
+        if (wrfbdy_next_slice.valid()) {
+            raw = wrfbdy_next_slice.get();
+        }
+        if (raw.nt != nt) {
+            raw = read_slice_from_wrfbdy(nc_bdy_file, nt);
+        }
+    }
+
+    // Each rank needs the data of the cells it fills, including the ghost cells
+    IntVect ngrow = vars_new[0][Vars::cons].nGrowVect();
+    ngrow.max(vars_new[0][Vars::xvel].nGrowVect());
+    ngrow.max(vars_new[0][Vars::yvel].nGrowVect());
+
+    wrfbdy_face_comms.define(domain, grids[0], dmap[0], ngrow);
+    distribute_wrfbdy_slice(raw, domain, wrfbdy_width, wrfbdy_face_comms,
+                            bdy_data_xlo[nt], bdy_data_xhi[nt], bdy_data_ylo[nt], bdy_data_yhi[nt]);
+
+    Vector<FArrayBox>* bdy_data[4] = {&bdy_data_xlo[nt], &bdy_data_xhi[nt], &bdy_data_ylo[nt], &bdy_data_yhi[nt]};
+    for (int face = 0; face < 4; face++)
+    {
+        const auto& c = wrfbdy_conv_fabs[face];
+        convert_wrfbdy_data(face, domain, *bdy_data[face], (nt == 0),
+                            c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+                            c[7], c[8], c[9], c[10], c[11], c[12]);
+    }
+}
+
+//
+// The NetCDF library is not thread-safe, so this must be called before any other NetCDF call
+//
+void
+ERF::finish_wrfbdy_prefetch () const
+{
+    if (wrfbdy_next_slice.valid()) wrfbdy_next_slice.wait();
+}
+
 //
 // mf is the MultiFab to be filled with data read in from wrfbdy
 // time is the time at which the data should be filled
@@ -186,6 +274,10 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
     amrex::Real alpha = (time - n_time * dT) / dT;
     amrex::Real oma   = 1.0 - alpha;
 
+    // These should have been read by update_wrfbdy_window
+    AMREX_ALWAYS_ASSERT(n_time+1 < wrfbdy_ntimes &&
+                        !bdy_data_xlo[n_time].empty() && !bdy_data_xlo[n_time+1].empty());
+
     for (int ivar = 0; ivar < WRFBdyVars::NumTypes-2; ivar++)
     {
         int icomp   = -1;
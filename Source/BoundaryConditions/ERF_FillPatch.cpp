@@ -95,6 +95,9 @@ ERF::FillPatch (int lev, Real time, const Vector<MultiFab*>& mfs)
 // This version fills the MultiFabs mfs in valid regions with the values in "mfs" when it is passed in;
 // it is used only to compute ghost values for intermediate stages of a time integrator.
 //
+// At level 0 the ghost cell exchanges for all the variables are posted before we wait for
+// any of them to complete.  They are not packed together since each variable has its own grids.
+//
 void
 ERF::FillIntermediatePatch (int lev, Real time,
                             const Vector<MultiFab*>& mfs,
@@ -153,7 +156,7 @@ ERF::FillIntermediatePatch (int lev, Real time,
 
         if (lev == 0)
         {
-            mf.FillBoundary(icomp,ncomp,ngvect,geom[lev].periodicity());
+            mf.FillBoundary_nowait(icomp,ncomp,ngvect,geom[lev].periodicity());
         }
         else
         {
@@ -168,6 +171,15 @@ ERF::FillIntermediatePatch (int lev, Real time,
         }
     }
 
+    if (lev == 0)
+    {
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
+        {
+            if (cons_only && var_idx != Vars::cons) continue;
+            mfs[var_idx]->FillBoundary_finish();
+        }
+    }
+
     // ***************************************************************************
     // Physical bc's at domain boundary
     // ***************************************************************************
@@ -5,8 +5,8 @@ using namespace amrex;
 void
 ComputeStrain_N(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz,
                 const Array4<const Real>& u, const Array4<const Real>& v, const Array4<const Real>& w,
-                Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
-                Array4<Real>& tau12, Array4<Real>& tau13, Array4<Real>& tau23,
+                Array4<AuxReal>& tau11, Array4<AuxReal>& tau22, Array4<AuxReal>& tau33,
+                Array4<AuxReal>& tau12, Array4<AuxReal>& tau13, Array4<AuxReal>& tau23,
                 const BCRec* bc_ptr, const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
                 const Array4<const Real>& mf_m, const Array4<const Real>& mf_u, const Array4<const Real>& mf_v)
 {
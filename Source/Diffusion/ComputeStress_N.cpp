@@ -4,8 +4,8 @@ using namespace amrex;
 
 void
 ComputeStressConsVisc_N(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
-                        Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
-                        Array4<Real>& tau12, Array4<Real>& tau13, Array4<Real>& tau23,
+                        Array4<AuxReal>& tau11, Array4<AuxReal>& tau22, Array4<AuxReal>& tau33,
+                        Array4<AuxReal>& tau12, Array4<AuxReal>& tau13, Array4<AuxReal>& tau23,
                         const Array4<const Real>& er_arr)
 {
     Real OneThird   = (1./3.);
@@ -36,8 +36,8 @@ ComputeStressConsVisc_N(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
 void
 ComputeStressVarVisc_N(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
                        const Array4<const Real>& mu_turb,
-                       Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
-                       Array4<Real>& tau12, Array4<Real>& tau13, Array4<Real>& tau23,
+                       Array4<AuxReal>& tau11, Array4<AuxReal>& tau22, Array4<AuxReal>& tau33,
+                       Array4<AuxReal>& tau12, Array4<AuxReal>& tau13, Array4<AuxReal>& tau23,
                        const Array4<const Real>& er_arr)
 {
     Real OneThird   = (1./3.);
@@ -5,10 +5,10 @@ using namespace amrex;
 
 void
 ComputeStressConsVisc_T(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
-                        Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
-                        Array4<Real>& tau12, Array4<Real>& tau13,
-                        Array4<Real>& tau21, Array4<Real>& tau23,
-                        Array4<Real>& tau31, Array4<Real>& tau32,
+                        Array4<AuxReal>& tau11, Array4<AuxReal>& tau22, Array4<AuxReal>& tau33,
+                        Array4<AuxReal>& tau12, Array4<AuxReal>& tau13,
+                        Array4<AuxReal>& tau21, Array4<AuxReal>& tau23,
+                        Array4<AuxReal>& tau31, Array4<AuxReal>& tau32,
                         const Array4<const Real>& er_arr,
                         const Array4<const Real>& z_nd  ,
                         const GpuArray<Real, AMREX_SPACEDIM>& dxInv)
@@ -230,10 +230,10 @@ ComputeStressConsVisc_T(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
 void
 ComputeStressVarVisc_T(Box bxcc, Box tbxxy, Box tbxxz, Box tbxyz, Real mu_eff,
                        const Array4<const Real>& mu_turb,
-                       Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
-                       Array4<Real>& tau12, Array4<Real>& tau13,
-                       Array4<Real>& tau21, Array4<Real>& tau23,
-                       Array4<Real>& tau31, Array4<Real>& tau32,
+                       Array4<AuxReal>& tau11, Array4<AuxReal>& tau22, Array4<AuxReal>& tau33,
+                       Array4<AuxReal>& tau12, Array4<AuxReal>& tau13,
+                       Array4<AuxReal>& tau21, Array4<AuxReal>& tau23,
+                       Array4<AuxReal>& tau31, Array4<AuxReal>& tau32,
                        const Array4<const Real>& er_arr,
                        const Array4<const Real>& z_nd  ,
                        const GpuArray<Real, AMREX_SPACEDIM>& dxInv)
@@ -15,13 +15,14 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
                               const amrex::Geometry& geom,
                               const SolverChoice& solverChoice,
                               std::unique_ptr<ABLMost>& most,
+                              ColumnSum& column_sum,
                               bool /*vert_only*/);
 
 /** Compute Eddy Viscosity */
-void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::MultiFab& Tau22, const amrex::MultiFab& Tau33,
-                                   const amrex::MultiFab& Tau12, const amrex::MultiFab& Tau13, const amrex::MultiFab& Tau23,
+void ComputeTurbulentViscosityLES (const AuxMultiFab& Tau11, const AuxMultiFab& Tau22, const AuxMultiFab& Tau33,
+                                   const AuxMultiFab& Tau12, const AuxMultiFab& Tau13, const AuxMultiFab& Tau23,
                                    const amrex::MultiFab& cons_in, amrex::MultiFab& eddyViscosity,
-                                   amrex::MultiFab& Hfx1, amrex::MultiFab& Hfx2, amrex::MultiFab& Hfx3, amrex::MultiFab& Diss,
+                                   AuxMultiFab& Hfx1, AuxMultiFab& Hfx2, AuxMultiFab& Hfx3, AuxMultiFab& Diss,
                                    const amrex::Geometry& geom,
                                    const amrex::MultiFab& mapfac_u, const amrex::MultiFab& mapfac_v,
                                    const SolverChoice& solverChoice)
@@ -45,12 +46,12 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
         const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
         const amrex::Array4<amrex::Real const > &cell_data = cons_in.array(mfi);
 
-        Array4<Real const> tau11 = Tau11.array(mfi);
-        Array4<Real const> tau22 = Tau22.array(mfi);
-        Array4<Real const> tau33 = Tau33.array(mfi);
-        Array4<Real const> tau12 = Tau12.array(mfi);
-        Array4<Real const> tau13 = Tau13.array(mfi);
-        Array4<Real const> tau23 = Tau23.array(mfi);
+        Array4<AuxReal const> tau11 = Tau11.array(mfi);
+        Array4<AuxReal const> tau22 = Tau22.array(mfi);
+        Array4<AuxReal const> tau33 = Tau33.array(mfi);
+        Array4<AuxReal const> tau12 = Tau12.array(mfi);
+        Array4<AuxReal const> tau13 = Tau13.array(mfi);
+        Array4<AuxReal const> tau23 = Tau23.array(mfi);
 
         Array4<Real const> mf_u = mapfac_u.array(mfi);
         Array4<Real const> mf_v = mapfac_v.array(mfi);
@@ -86,10 +87,10 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
           Box bxcc  = mfi.tilebox();
 
         const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
-        const Array4<Real>& hfx_x   = Hfx1.array(mfi);
-        const Array4<Real>& hfx_y   = Hfx2.array(mfi);
-        const Array4<Real>& hfx_z   = Hfx3.array(mfi);
-        const Array4<Real>& diss    = Diss.array(mfi);
+        const Array4<AuxReal>& hfx_x   = Hfx1.array(mfi);
+        const Array4<AuxReal>& hfx_y   = Hfx2.array(mfi);
+        const Array4<AuxReal>& hfx_z   = Hfx3.array(mfi);
+        const Array4<AuxReal>& diss    = Diss.array(mfi);
 
         const amrex::Array4<amrex::Real const > &cell_data = cons_in.array(mfi);
 
@@ -319,15 +320,16 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
 }
 
 void ComputeTurbulentViscosity (const amrex::MultiFab& xvel , const amrex::MultiFab& yvel ,
-                                const amrex::MultiFab& Tau11, const amrex::MultiFab& Tau22, const amrex::MultiFab& Tau33,
-                                const amrex::MultiFab& Tau12, const amrex::MultiFab& Tau13, const amrex::MultiFab& Tau23,
+                                const AuxMultiFab& Tau11, const AuxMultiFab& Tau22, const AuxMultiFab& Tau33,
+                                const AuxMultiFab& Tau12, const AuxMultiFab& Tau13, const AuxMultiFab& Tau23,
                                 const amrex::MultiFab& cons_in,
                                 amrex::MultiFab& eddyViscosity,
-                                amrex::MultiFab& Hfx1, amrex::MultiFab& Hfx2, amrex::MultiFab& Hfx3, amrex::MultiFab& Diss,
+                                AuxMultiFab& Hfx1, AuxMultiFab& Hfx2, AuxMultiFab& Hfx3, AuxMultiFab& Diss,
                                 const amrex::Geometry& geom,
                                 const amrex::MultiFab& mapfac_u, const amrex::MultiFab& mapfac_v,
                                 const SolverChoice& solverChoice,
                                 std::unique_ptr<ABLMost>& most,
+                                ColumnSum* pbl_column_sum,
                                 bool vert_only)
 {
     BL_PROFILE_VAR("ComputeTurbulentViscosity()",ComputeTurbulentViscosity);
@@ -365,7 +367,8 @@ void ComputeTurbulentViscosity (const amrex::MultiFab& xvel , const amrex::Multi
     }
 
     if (solverChoice.pbl_type != PBLType::None) {
+        AMREX_ALWAYS_ASSERT(pbl_column_sum != nullptr);
         ComputeTurbulentViscosityPBL(xvel, yvel, cons_in, eddyViscosity,
-                                     geom, solverChoice, most, vert_only);
+                                     geom, solverChoice, most, *pbl_column_sum, vert_only);
     }
 }
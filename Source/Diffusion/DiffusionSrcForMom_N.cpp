@@ -9,9 +9,9 @@ DiffusionSrcForMom_N (const Box& bxx, const Box& bxy , const Box& bxz,
                       const Array4<Real>& rho_u_rhs  ,
                       const Array4<Real>& rho_v_rhs  ,
                       const Array4<Real>& rho_w_rhs  ,
-                      const Array4<const Real>& tau11, const Array4<const Real>& tau22,
-                      const Array4<const Real>& tau33, const Array4<const Real>& tau12,
-                      const Array4<const Real>& tau13, const Array4<const Real>& tau23,
+                      const Array4<const AuxReal>& tau11, const Array4<const AuxReal>& tau22,
+                      const Array4<const AuxReal>& tau33, const Array4<const AuxReal>& tau12,
+                      const Array4<const AuxReal>& tau13, const Array4<const AuxReal>& tau23,
                       const Array4<const Real>& cons , const SolverChoice& solverChoice,
                       const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
                       const Array4<const Real>& mf_m,
@@ -9,10 +9,10 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
                       const Array4<Real>& rho_u_rhs  ,
                       const Array4<Real>& rho_v_rhs  ,
                       const Array4<Real>& rho_w_rhs  ,
-                      const Array4<const Real>& tau11, const Array4<const Real>& tau22, const Array4<const Real>& tau33,
-                      const Array4<const Real>& tau12, const Array4<const Real>& tau13,
-                      const Array4<const Real>& tau21, const Array4<const Real>& tau23,
-                      const Array4<const Real>& tau31, const Array4<const Real>& tau32,
+                      const Array4<const AuxReal>& tau11, const Array4<const AuxReal>& tau22, const Array4<const AuxReal>& tau33,
+                      const Array4<const AuxReal>& tau12, const Array4<const AuxReal>& tau13,
+                      const Array4<const AuxReal>& tau21, const Array4<const AuxReal>& tau23,
+                      const Array4<const AuxReal>& tau31, const Array4<const AuxReal>& tau32,
                       const Array4<const Real>& cons , const Array4<const Real>& detJ ,
                       const SolverChoice& solverChoice,
                       const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
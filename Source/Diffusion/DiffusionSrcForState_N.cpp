@@ -16,12 +16,12 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain,
                         const Array4<Real>& yflux,
                         const Array4<Real>& zflux,
                         const amrex::GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                        const Array4<const Real>& SmnSmn_a,
+                        const Array4<const AuxReal>& SmnSmn_a,
                         const Array4<const Real>& mf_m,
                         const Array4<const Real>& mf_u,
                         const Array4<const Real>& mf_v,
-                              Array4<      Real>& hfx_z,
-                              Array4<      Real>& diss,
+                              Array4<      AuxReal>& hfx_z,
+                              Array4<      AuxReal>& diss,
                         const Array4<const Real>& mu_turb,
                         const SolverChoice &solverChoice,
                         const Array4<const Real>& tm_arr,
@@ -19,12 +19,12 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain,
                         const Array4<const Real>& z_nd,
                         const Array4<const Real>& detJ,
                         const amrex::GpuArray<Real, AMREX_SPACEDIM>& dxInv,
-                        const Array4<const Real>& SmnSmn_a,
+                        const Array4<const AuxReal>& SmnSmn_a,
                         const Array4<const Real>& mf_m,
                         const Array4<const Real>& mf_u,
                         const Array4<const Real>& mf_v,
-                              Array4<      Real>& hfx_z,
-                              Array4<      Real>& diss,
+                              Array4<      AuxReal>& hfx_z,
+                              Array4<      AuxReal>& diss,
                         const Array4<const Real>& mu_turb,
                         const SolverChoice &solverChoice,
                         const Array4<const Real>& tm_arr,
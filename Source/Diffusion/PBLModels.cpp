@@ -1,6 +1,7 @@
 #include "ABLMost.H"
 #include "DirectionSelector.H"
 #include "Diffusion.H"
+#include "ERF_ColumnSum.H"
 
 void
 ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
@@ -10,6 +11,7 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
                               const amrex::Geometry& geom,
                               const SolverChoice& solverChoice,
                               std::unique_ptr<ABLMost>& most,
+                              ColumnSum& column_sum,
                               bool /*vert_only*/)
 {
   // MYNN Level 2.5 PBL Model
@@ -25,6 +27,66 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
     //const amrex::Real C4 = solverChoice.pbl_C4;
     const amrex::Real C5 = solverChoice.pbl_C5;
 
+    const amrex::GeometryData gdata = geom.data();
+    int izmin = geom.Domain().smallEnd(2);
+    int izmax = geom.Domain().bigEnd(2);
+
+    const auto& t_mean_mf = most->get_mac_avg(0,2); // TODO: IS THIS ACTUALLY RHOTHETA
+    const auto& u_star_mf = most->get_u_star(0);    // Use coarsest level
+    const auto& t_star_mf = most->get_t_star(0);    // Use coarsest level
+
+    // Compute some quantities that are constant in each column: the integrals of Zval*qvel
+    // and qvel over the column and the surface values from MOST.  The boxes need not span
+    // the vertical domain; the surface values are taken from the box at the bottom of the
+    // column and passed up with the integrals.  column_sum is kept with the level, so it
+    // is only (re)built the first time through and after we regrid.
+    enum { QInt_zq = 0, QInt_q, Surf_ustar, Surf_tstar, Surf_theta, NumColumnSums };
+    if (!column_sum.matches(eddyViscosity.boxArray(), eddyViscosity.DistributionMap(),
+                            NumColumnSums, amrex::IntVect(1,1,0))) {
+        column_sum.define(eddyViscosity.boxArray(), eddyViscosity.DistributionMap(), geom,
+                          NumColumnSums, amrex::IntVect(1,1,0));
+    }
+
+    for ( amrex::MFIter mfi(column_sum.sums()); mfi.isValid(); ++mfi) {
+
+      const amrex::Box cbx = column_sum.column_box(mfi);
+      const amrex::Array4<amrex::Real const> &cell_data = cons_in.array(mfi);
+      const amrex::Array4<amrex::Real> &qint = column_sum.sums().array(mfi);
+
+      const int klo = cbx.smallEnd(2);
+      const int khi = cbx.bigEnd(2);
+      const bool has_surface = (klo == izmin);
+
+      amrex::Array4<amrex::Real const> tm_arr, u_star_arr, t_star_arr;
+      if (has_surface) {
+          tm_arr     = t_mean_mf->const_array(mfi); // TODO: IS THIS ACTUALLY RHOTHETA
+          u_star_arr = u_star_mf->const_array(mfi);
+          t_star_arr = t_star_mf->const_array(mfi);
+      }
+
+      const amrex::Box xybx = PerpendicularBox<ZDir>(cbx, amrex::IntVect{0,0,0});
+      amrex::ParallelFor(xybx, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+      {
+          amrex::Real zq_sum = 0.0;
+          amrex::Real q_sum  = 0.0;
+          for (int k = klo; k <= khi; ++k) {
+              const amrex::Real Zval = gdata.ProbLo(2) + (k + 0.5)*gdata.CellSize(2);
+              const amrex::Real qvel = std::sqrt(cell_data(i,j,k,RhoQKE_comp) / cell_data(i,j,k,Rho_comp));
+              // We will divide by qvel later
+              AMREX_ASSERT_WITH_MESSAGE(qvel > 0.0, "QKE must have a positive value");
+              zq_sum += Zval*qvel;
+              q_sum  += qvel;
+          }
+          qint(i,j,0,QInt_zq) = zq_sum;
+          qint(i,j,0,QInt_q)  = q_sum;
+          qint(i,j,0,Surf_ustar) = has_surface ? u_star_arr(i,j,0) : 0.0;
+          qint(i,j,0,Surf_tstar) = has_surface ? t_star_arr(i,j,0) : 0.0;
+          qint(i,j,0,Surf_theta) = has_surface ? tm_arr(i,j,0)     : 0.0;
+      });
+    }
+
+    column_sum.reduce();
+
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -35,57 +97,19 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
       const amrex::Array4<amrex::Real> &K_turb = eddyViscosity.array(mfi);
       const amrex::Array4<amrex::Real const> &uvel = xvel.array(mfi);
       const amrex::Array4<amrex::Real const> &vvel = yvel.array(mfi);
-
-      // Compute some quantities that are constant in each column
-      // Sbox is shrunk to only include the interior of the domain in the vertical direction to compute integrals
-      // NOTE: Here we requite that sbx covers the entire vertical domain
-      const amrex::Box &dbx = geom.Domain();
-      amrex::Box sbx(bx.smallEnd(), bx.bigEnd());
-      sbx.grow(2,-1);
-      AMREX_ALWAYS_ASSERT(sbx.smallEnd(2) == dbx.smallEnd(2) && sbx.bigEnd(2) == dbx.bigEnd(2));
-
-      const amrex::GeometryData gdata = geom.data();
-
-      const amrex::Box xybx = PerpendicularBox<ZDir>(bx, amrex::IntVect{0,0,0});
-      amrex::FArrayBox qintegral(xybx,2);
-      qintegral.setVal<amrex::RunOn::Device>(0.0);
-      amrex::FArrayBox qturb(bx,1);
-      const amrex::Array4<amrex::Real> qint = qintegral.array();
-      const amrex::Array4<amrex::Real> qvel= qturb.array();
-
-      amrex::ParallelFor(amrex::Gpu::KernelInfo().setReduction(true), bx,
-                         [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::Gpu::Handler const& handler) noexcept
-      {
-          const amrex::Real Zval = gdata.ProbLo(2) + (k + 0.5)*gdata.CellSize(2);
-          const amrex::Real rho = cell_data(i,j,k,Rho_comp);
-          qvel(i,j,k) = std::sqrt(cell_data(i,j,k,RhoQKE_comp) / rho);
-          // We will divide by qvel later
-          AMREX_ASSERT_WITH_MESSAGE(qvel(i,j,k) > 0.0, "QKE must have a positive value");
-          if (sbx.contains(i,j,k)) {
-              amrex::Gpu::deviceReduceSum(&qint(i,j,0,0), Zval*qvel(i,j,k), handler);
-              amrex::Gpu::deviceReduceSum(&qint(i,j,0,1), qvel(i,j,k), handler);
-          }
-      });
+      const amrex::Array4<amrex::Real const> &qint = column_sum.sums().const_array(mfi);
 
       amrex::Real dz_inv = geom.InvCellSize(2);
-      int izmin = geom.Domain().smallEnd(2);
-      int izmax = geom.Domain().bigEnd(2);
 
       // Spatially varying MOST
       amrex::Real eps       = 1.0e-16;
       amrex::Real d_kappa   = most->kappa;
       amrex::Real d_gravity = most->gravity;
 
-      const auto& t_mean_mf = most->get_mac_avg(0,2); // TODO: IS THIS ACTUALLY RHOTHETA
-      const auto& u_star_mf = most->get_u_star(0);    // Use coarsest level
-      const auto& t_star_mf = most->get_t_star(0);    // Use coarsest level
-
-      const auto& tm_arr     = t_mean_mf->array(mfi); // TODO: IS THIS ACTUALLY RHOTHETA
-      const auto& u_star_arr = u_star_mf->array(mfi);
-      const auto& t_star_arr = t_star_mf->array(mfi);
-
       amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
       {
+          const amrex::Real qvel = std::sqrt(cell_data(i,j,k,RhoQKE_comp) / cell_data(i,j,k,Rho_comp));
+
           // Compute some partial derivatives that we will need (1st order at domain boundary)
           // U and V derivatives are interpolated to account for staggered grid
           amrex::Real dthetadz, dudz, dvdz;
@@ -107,12 +131,14 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
           }
 
           // Spatially varying MOST
-          amrex::Real surface_heat_flux = u_star_arr(i,k,0) * t_star_arr(i,j,0);
-          amrex::Real theta0            = tm_arr(i,j,0); // TODO: IS THIS ACTUALLY RHOTHETA
+          const amrex::Real u_star = qint(i,j,0,Surf_ustar);
+          const amrex::Real t_star = qint(i,j,0,Surf_tstar);
+          amrex::Real surface_heat_flux = u_star * t_star;
+          amrex::Real theta0            = qint(i,j,0,Surf_theta); // TODO: IS THIS ACTUALLY RHOTHETA
           amrex::Real l_obukhov;
           if (std::abs(surface_heat_flux) > eps) {
-              l_obukhov = ( theta0 * u_star_arr(i,j,0) * u_star_arr(i,j,0) ) /
-                          ( d_kappa * d_gravity * t_star_arr(i,j,0) );
+              l_obukhov = ( theta0 * u_star * u_star ) /
+                          ( d_kappa * d_gravity * t_star );
           } else {
               l_obukhov = std::numeric_limits<amrex::Real>::max();
           }
@@ -132,8 +158,8 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
 
           // Second Length Scale
           amrex::Real l_T;
-          if (qint(i,j,0,1) > 0.0) {
-              l_T = 0.23*qint(i,j,0,0)/qint(i,j,0,1);
+          if (qint(i,j,0,QInt_q) > 0.0) {
+              l_T = 0.23*qint(i,j,0,QInt_zq)/qint(i,j,0,QInt_q);
           } else {
               l_T = std::numeric_limits<amrex::Real>::max();
           }
@@ -145,9 +171,9 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
               if (zeta < 0) {
                   amrex::Real qc = CONST_GRAV/theta0 * surface_heat_flux * l_T;
                   qc = std::pow(qc,1.0/3.0);
-                  l_B = (1.0 + 5.0*std::sqrt(qc/(N_brunt_vaisala * l_T))) * qvel(i,j,k)/N_brunt_vaisala;
+                  l_B = (1.0 + 5.0*std::sqrt(qc/(N_brunt_vaisala * l_T))) * qvel/N_brunt_vaisala;
               } else {
-                  l_B = qvel(i,j,k) / N_brunt_vaisala;
+                  l_B = qvel / N_brunt_vaisala;
               }
           } else {
               l_B = std::numeric_limits<amrex::Real>::max();
@@ -157,7 +183,7 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
           amrex::Real l_comb = 1.0 / (1.0/l_S + 1.0/l_T + 1.0/l_B);
 
           // Compute non-dimensional parameters
-          amrex::Real l2_over_q2 = l_comb*l_comb/(qvel(i,j,k)*qvel(i,j,k));
+          amrex::Real l2_over_q2 = l_comb*l_comb/(qvel*qvel);
           amrex::Real GM = l2_over_q2 * (dudz*dudz + dvdz*dvdz);
           amrex::Real GH = -l2_over_q2 / theta0 * dthetadz;
           amrex::Real E1 = 1.0 + 6.0*A1*A1*GM - 9.0*A1*A2*(1.0-C2)*GH;
@@ -172,9 +198,9 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
 
           // Finally, compute the eddy viscosity/diffusivities
           const amrex::Real rho = cell_data(i,j,k,Rho_comp);
-          K_turb(i,j,k,EddyDiff::Mom_v)   = rho * l_comb * qvel(i,j,k) * SM * 0.5;
-          K_turb(i,j,k,EddyDiff::Theta_v) = rho * l_comb * qvel(i,j,k) * SH;
-          K_turb(i,j,k,EddyDiff::QKE_v)   = rho * l_comb * qvel(i,j,k) * 3.0 * SQ;
+          K_turb(i,j,k,EddyDiff::Mom_v)   = rho * l_comb * qvel * SM * 0.5;
+          K_turb(i,j,k,EddyDiff::Theta_v) = rho * l_comb * qvel * SH;
+          K_turb(i,j,k,EddyDiff::QKE_v)   = rho * l_comb * qvel * 3.0 * SQ;
 
           K_turb(i,j,k,EddyDiff::PBL_lengthscale) = l_comb;
           // TODO: How should this be done for other components (scalars, moisture)
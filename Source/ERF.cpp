@@ -10,6 +10,7 @@
 
 #include <Utils.H>
 #include <TerrainMetrics.H>
+#include <ERF_BatchedFillBoundary.H>
 #include <memory>
 
 #ifdef ERF_USE_MULTIBLOCK
@@ -32,6 +33,7 @@ amrex::Real ERF::fixed_fast_dt = -1.0;
 amrex::Real ERF::init_shrink   =  1.0;
 amrex::Real ERF::change_max    =  1.1;
 int         ERF::fixed_mri_dt_ratio = 0;
+amrex::Real ERF::fast_cfl      = -1.0;
 
 // Type of mesh refinement algorithm
 std::string ERF::coupling_type = "OneWay";
@@ -164,6 +166,9 @@ ERF::ERF ()
 #endif
 
     mri_integrator_mem.resize(nlevs_max);
+    fast_scratch_lev.resize(nlevs_max);
+    advance_buffers_lev.resize(nlevs_max);
+    pbl_column_sum_lev.resize(nlevs_max);
     physbcs.resize(nlevs_max);
 
     flux_registers.resize(nlevs_max);
@@ -208,6 +213,14 @@ ERF::Evolve ()
             m_r2d->read_input_files(cur_time,dt[0],m_bc_extdir_vals);
         }
 
+#ifdef ERF_USE_NETCDF
+        // Make sure we have read enough of the wrfbdy data to make it through this timestep
+        if (init_type == "real")
+        {
+            update_wrfbdy_window(cur_time,dt[0]);
+        }
+#endif
+
         int lev = 0;
         int iteration = 1;
         timeStep(lev, cur_time, iteration);
@@ -240,6 +253,9 @@ ERF::Evolve ()
             }
         }
 
+        // Rename a checkpoint written in the background if it is complete
+        CommitCheckpointFile(false);
+
 #ifdef AMREX_MEM_PROFILING
         {
             std::ostringstream ss;
@@ -269,6 +285,8 @@ ERF::Evolve ()
         }
     }
 
+    // Finish any checkpoint still being written in the background
+    CommitCheckpointFile(true);
 }
 
 // Called after every coarse timestep
@@ -862,8 +880,14 @@ ERF::ClearLevel (int lev)
 
     // Clears the integrator memory
     mri_integrator_mem[lev].reset();
+    fast_scratch_lev[lev].reset();
+    advance_buffers_lev[lev].reset();
+    pbl_column_sum_lev[lev].reset();
     physbcs[lev].reset();
 
+    // The packed ghost cell exchange buffers are keyed on the grids, which are going away
+    BatchedFillBoundary::clear_cache();
+
     grids_to_evolve[lev].clear();
 }
 
@@ -956,25 +980,25 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
     SmnSmn_lev.resize(lev+1);
 
     if (l_use_diff) {
-        Tau11_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        Tau22_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        Tau33_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        Tau12_lev[lev] = std::make_unique<MultiFab>( ba12, dm, 1, IntVect(1,1,0) );
-        Tau13_lev[lev] = std::make_unique<MultiFab>( ba13, dm, 1, IntVect(1,1,0) );
-        Tau23_lev[lev] = std::make_unique<MultiFab>( ba23, dm, 1, IntVect(1,1,0) );
+        Tau11_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        Tau22_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        Tau33_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        Tau12_lev[lev] = std::make_unique<AuxMultiFab>( ba12, dm, 1, IntVect(1,1,0) );
+        Tau13_lev[lev] = std::make_unique<AuxMultiFab>( ba13, dm, 1, IntVect(1,1,0) );
+        Tau23_lev[lev] = std::make_unique<AuxMultiFab>( ba23, dm, 1, IntVect(1,1,0) );
         if (l_use_terrain) {
-            Tau21_lev[lev] = std::make_unique<MultiFab>( ba12, dm, 1, IntVect(1,1,0) );
-            Tau31_lev[lev] = std::make_unique<MultiFab>( ba13, dm, 1, IntVect(1,1,0) );
-            Tau32_lev[lev] = std::make_unique<MultiFab>( ba23, dm, 1, IntVect(1,1,0) );
+            Tau21_lev[lev] = std::make_unique<AuxMultiFab>( ba12, dm, 1, IntVect(1,1,0) );
+            Tau31_lev[lev] = std::make_unique<AuxMultiFab>( ba13, dm, 1, IntVect(1,1,0) );
+            Tau32_lev[lev] = std::make_unique<AuxMultiFab>( ba23, dm, 1, IntVect(1,1,0) );
         } else {
             Tau21_lev[lev] = nullptr;
             Tau31_lev[lev] = nullptr;
             Tau32_lev[lev] = nullptr;
         }
-        SFS_hfx1_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        SFS_hfx2_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        SFS_hfx3_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
-        SFS_diss_lev[lev] = std::make_unique<MultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        SFS_hfx1_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        SFS_hfx2_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        SFS_hfx3_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
+        SFS_diss_lev[lev] = std::make_unique<AuxMultiFab>( ba  , dm, 1, IntVect(1,1,0) );
     } else {
       Tau11_lev[lev] = nullptr; Tau22_lev[lev] = nullptr; Tau33_lev[lev] = nullptr;
       Tau12_lev[lev] = nullptr; Tau21_lev[lev] = nullptr;
@@ -987,7 +1011,7 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
     if (l_use_kturb) {
       eddyDiffs_lev[lev] = std::make_unique<MultiFab>( ba, dm, EddyDiff::NumDiffs, 1 );
       if(l_use_ddorf) {
-          SmnSmn_lev[lev] = std::make_unique<MultiFab>( ba, dm, 1, 0 );
+          SmnSmn_lev[lev] = std::make_unique<AuxMultiFab>( ba, dm, 1, 0 );
       } else {
           SmnSmn_lev[lev] = nullptr;
       }
@@ -1108,23 +1132,43 @@ ERF::initialize_integrator(int lev, MultiFab& cons_mf, MultiFab& vel_mf)
     const BoxArray& ba(cons_mf.boxArray());
     const DistributionMapping& dm(cons_mf.DistributionMap());
 
-    // Initialize the integrator memory
-    int use_fluxes = (finest_level > 0);
+    // Initialize the integrator memory -- the integrator sizes its own scratch space
+    // for each variable from this example of the integration state
     amrex::Vector<amrex::MultiFab> int_state; // integration state data structure example
     int_state.push_back(MultiFab(cons_mf, amrex::make_alias, 0, Cons::NumVars)); // cons
     int_state.push_back(MultiFab(convert(ba,IntVect(1,0,0)), dm, 1, vel_mf.nGrow())); // xmom
     int_state.push_back(MultiFab(convert(ba,IntVect(0,1,0)), dm, 1, vel_mf.nGrow())); // ymom
     int_state.push_back(MultiFab(convert(ba,IntVect(0,0,1)), dm, 1, vel_mf.nGrow())); // zmom
-    if (use_fluxes) {
-        int_state.push_back(MultiFab(convert(ba,IntVect(1,0,0)), dm, Cons::NumVars, 1)); // x-fluxes
-        int_state.push_back(MultiFab(convert(ba,IntVect(0,1,0)), dm, Cons::NumVars, 1)); // y-fluxes
-        int_state.push_back(MultiFab(convert(ba,IntVect(0,0,1)), dm, Cons::NumVars, 1)); // z-fluxes
+    for (int i = 1; i < int_state.size(); ++i) {
+        StateBufferStats::add_alloc(int_state[i]);
     }
 
     mri_integrator_mem[lev] = std::make_unique<MRISplitIntegrator<amrex::Vector<amrex::MultiFab> > >(int_state);
     mri_integrator_mem[lev]->setNoSubstepping(no_substepping);
     mri_integrator_mem[lev]->setForceFirstStageSingleSubstep(force_stage1_single_substep);
 
+    // Scratch space for the acoustic substeps -- this persists until the next regrid
+    if (!no_substepping) {
+        fast_scratch_lev[lev] = std::make_unique<FastRhsScratch>(ba, dm, solverChoice.use_terrain,
+                                                                 solverChoice.terrain_type);
+    } else {
+        fast_scratch_lev[lev] = nullptr;
+    }
+
+    // The grids have changed, so drop any packed ghost cell exchange buffers made for the old ones
+    BatchedFillBoundary::clear_cache();
+
+    // Buffers used by Advance -- these also persist until the next regrid
+    advance_buffers_lev[lev] = std::make_unique<AdvanceBuffers>(ba, dm, Cons::NumVars, cons_mf.nGrowVect(),
+                                                                (init_type == "real"));
+
+    // Column integrals for the PBL model -- defined on first use, and dropped here since the grids have changed
+    if (solverChoice.pbl_type == PBLType::MYNN25) {
+        pbl_column_sum_lev[lev] = std::make_unique<ColumnSum>();
+    } else {
+        pbl_column_sum_lev[lev] = nullptr;
+    }
+
     physbcs[lev] = std::make_unique<ERFPhysBCFunct> (lev, geom[lev], domain_bcs_type, domain_bcs_type_d,
                                                      solverChoice.terrain_type, m_bc_extdir_vals, m_bc_neumann_vals,
                                                      z_phys_nd[lev], detJ_cc[lev]);
@@ -1252,6 +1296,14 @@ ERF::ReadParameters ()
             }
         }
 
+        pp.query("fast_cfl", fast_cfl);
+
+        // The substeps are either fixed or adaptive
+        if (fast_cfl > 0. && (fixed_fast_dt > 0. || fixed_mri_dt_ratio > 0))
+        {
+            amrex::Abort("fast_cfl can not be used with fixed_fast_dt or fixed_mri_dt_ratio");
+        }
+
         AMREX_ASSERT(cfl > 0. || fixed_dt > 0.);
 
         // Mesh refinement
@@ -1311,6 +1363,30 @@ ERF::ReadParameters ()
 
         // NetCDF wrfbdy lateral boundary file
         pp.query("nc_bdy_file", nc_bdy_file);
+        pp.query("wrfbdy_prefetch", wrfbdy_prefetch);
+
+        // Compression of NetCDF output
+        pp.query("nc_check_deflate", nc_check_deflate);
+        pp.query("nc_plot_deflate", nc_plot_deflate);
+        if (pp.contains("nc_plot_abs_error_vars")) {
+            Vector<std::string> abs_error_vars;
+            Vector<Real> abs_error;
+            pp.getarr("nc_plot_abs_error_vars", abs_error_vars);
+            pp.getarr("nc_plot_abs_error", abs_error);
+            if (abs_error.size() != abs_error_vars.size()) {
+                amrex::Abort("erf.nc_plot_abs_error must have one value per erf.nc_plot_abs_error_vars");
+            }
+            for (int i = 0; i < abs_error_vars.size(); ++i) {
+                nc_plot_abs_error[abs_error_vars[i]] = abs_error[i];
+            }
+            // The rounding only saves space if deflate then removes the zeroed bits
+            if (nc_plot_deflate <= 0) {
+                amrex::Abort("erf.nc_plot_abs_error_vars requires erf.nc_plot_deflate > 0");
+            }
+        }
+
+        // Aggregation of NetCDF output
+        pp.query("nc_num_aggregators", nc_num_aggregators);
 #endif
 
         // Text input_sounding file
@@ -1332,6 +1408,8 @@ ERF::ReadParameters ()
         pp.query("plot_file_2", plot_file_2);
         pp.query("plot_int_1", plot_int_1);
         pp.query("plot_int_2", plot_int_2);
+        pp.query("plot_max_inflight", plot_max_inflight);
+        pp.query("plot_float", plot_float);
 
         pp.query("profile_int", profile_int);
 
@@ -1620,6 +1698,9 @@ ERF::ERF (const amrex::RealBox& rb, int max_level_in,
 #endif
 
     mri_integrator_mem.resize(nlevs_max);
+    fast_scratch_lev.resize(nlevs_max);
+    advance_buffers_lev.resize(nlevs_max);
+    pbl_column_sum_lev.resize(nlevs_max);
     physbcs.resize(nlevs_max);
 
     // Multiblock: public domain sizes (need to know which vars are nodal)
@@ -1675,6 +1756,14 @@ ERF::Evolve_MB (int MBstep, int max_block_step)
             m_r2d->read_input_files(cur_time,dt[0],m_bc_extdir_vals);
         }
 
+#ifdef ERF_USE_NETCDF
+        // Make sure we have read enough of the wrfbdy data to make it through this timestep
+        if (init_type == "real")
+        {
+            update_wrfbdy_window(cur_time,dt[0]);
+        }
+#endif
+
         int lev = 0;
         int iteration = 1;
         timeStep(lev, cur_time, iteration);
@@ -1716,6 +1805,9 @@ ERF::Evolve_MB (int MBstep, int max_block_step)
             }
         }
 
+        // Rename a checkpoint written in the background if it is complete
+        CommitCheckpointFile(false);
+
 #ifdef AMREX_MEM_PROFILING
         {
             std::ostringstream ss;
@@ -1745,5 +1837,7 @@ ERF::Evolve_MB (int MBstep, int max_block_step)
         }
     }
 
+    // Finish any checkpoint still being written in the background
+    CommitCheckpointFile(true);
 }
 #endif
@@ -1,8 +1,28 @@
 #include <ERF.H>
 #include "AMReX_PlotFileUtil.H"
 
+#include <condition_variable>
+#include <mutex>
+
 using namespace amrex;
 
+namespace {
+
+// The checkpoint being written by the AsyncOut thread into a temporary directory,
+// and whether this rank has finished writing its part of it
+std::string             pending_checkpoint;
+std::mutex              pending_mutex;
+std::condition_variable pending_cv;
+bool                    pending_written = false;
+
+std::string
+temporary_checkpoint_name (const std::string& checkpointname)
+{
+    return checkpointname + ".inprogress";
+}
+
+} // namespace
+
 /**
  * Utility to skip to next line in Header file input stream.
  */
@@ -31,6 +51,26 @@ ERF::WriteCheckpointFile () const
 
     amrex::Print() << "Writing checkpoint " << checkpointname << "\n";
 
+    // With amrex.async_out the MultiFab data are copied to host buffers and written by a
+    //     background thread while we go on stepping.  They are written into a temporary
+    //     directory that CommitCheckpointFile renames once every rank is done, so that a
+    //     directory named checkpointname is always a complete checkpoint.  We hold on to
+    //     at most one such snapshot, so we first finish the previous checkpoint.
+    const bool l_async = AsyncOut::UseAsyncOut();
+    if (l_async) {
+        CommitCheckpointFile(true);
+    }
+    const std::string chkdirname = l_async ? temporary_checkpoint_name(checkpointname) : checkpointname;
+
+    auto write_mf = [l_async] (MultiFab&& mf, const std::string& mf_name)
+    {
+        if (l_async) {
+            VisMF::AsyncWrite(std::move(mf), mf_name);
+        } else {
+            VisMF::Write(mf, mf_name);
+        }
+    };
+
     const int nlevels = finest_level+1;
 
     // ---- prebuild a hierarchy of directories
@@ -39,12 +79,12 @@ ERF::WriteCheckpointFile () const
     // ---- if callBarrier is true, call ParallelDescriptor::Barrier()
     // ---- after all directories are built
     // ---- ParallelDescriptor::IOProcessor() creates the directories
-    amrex::PreBuildDirectorHierarchy(checkpointname, "Level_", nlevels, true);
+    amrex::PreBuildDirectorHierarchy(chkdirname, "Level_", nlevels, true);
 
     // write Header file
    if (ParallelDescriptor::IOProcessor()) {
 
-       std::string HeaderFileName(checkpointname + "/Header");
+       std::string HeaderFileName(chkdirname + "/Header");
        VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
        std::ofstream HeaderFile;
        HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
@@ -109,32 +149,82 @@ ERF::WriteCheckpointFile () const
    {
        MultiFab cons(grids[lev],dmap[lev],Cons::NumVars,0);
        MultiFab::Copy(cons,vars_new[lev][Vars::cons],0,0,NVAR,0);
-       VisMF::Write(cons, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "Cell"));
+       write_mf(std::move(cons), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "Cell"));
 
        MultiFab xvel(convert(grids[lev],IntVect(1,0,0)),dmap[lev],1,0);
        MultiFab::Copy(xvel,vars_new[lev][Vars::xvel],0,0,1,0);
-       VisMF::Write(xvel, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "XFace"));
+       write_mf(std::move(xvel), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "XFace"));
 
        MultiFab yvel(convert(grids[lev],IntVect(0,1,0)),dmap[lev],1,0);
        MultiFab::Copy(yvel,vars_new[lev][Vars::yvel],0,0,1,0);
-       VisMF::Write(yvel, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "YFace"));
+       write_mf(std::move(yvel), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "YFace"));
 
        MultiFab zvel(convert(grids[lev],IntVect(0,0,1)),dmap[lev],1,0);
        MultiFab::Copy(zvel,vars_new[lev][Vars::zvel],0,0,1,0);
-       VisMF::Write(zvel, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "ZFace"));
+       write_mf(std::move(zvel), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "ZFace"));
 
        MultiFab base(grids[lev],dmap[lev],base_state[lev].nComp(),0);
        MultiFab::Copy(base,base_state[lev],0,0,base.nComp(),0);
-       VisMF::Write(base, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "BaseState"));
+       write_mf(std::move(base), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "BaseState"));
 
        if (solverChoice.use_terrain)  {
            // Note that we write the ghost cells of z_phys_nd (unlike above)
            IntVect ngvect = z_phys_nd[lev]->nGrowVect();
            MultiFab z_height(convert(grids[lev],IntVect(1,1,1)),dmap[lev],1,ngvect);
            MultiFab::Copy(z_height,*z_phys_nd[lev],0,0,1,ngvect);
-           VisMF::Write(z_height, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "Z_Phys_nd"));
+           write_mf(std::move(z_height), amrex::MultiFabFileFullPrefix(lev, chkdirname, "Level_", "Z_Phys_nd"));
        }
    }
+
+   if (l_async) {
+       pending_checkpoint = checkpointname;
+       pending_written = false;
+       // The AsyncOut thread runs its tasks in order, so this rank's data are on disk
+       //     once this task has run
+       AsyncOut::Submit([] () {
+           {
+               std::lock_guard<std::mutex> lock(pending_mutex);
+               pending_written = true;
+           }
+           pending_cv.notify_all();
+       });
+   }
+}
+
+/**
+ * Give the checkpoint being written in the background its final name if every rank has
+ * finished writing it.  If wait is true we wait for that; otherwise this returns at once
+ * if some rank is still writing.  This must be called by every rank.
+ */
+void
+ERF::CommitCheckpointFile (bool wait)
+{
+    if (pending_checkpoint.empty()) return;
+
+    BL_PROFILE("ERF::CommitCheckpointFile()");
+
+    int written;
+    {
+        std::unique_lock<std::mutex> lock(pending_mutex);
+        if (wait) {
+            pending_cv.wait(lock, [] () { return pending_written; });
+        }
+        written = pending_written ? 1 : 0;
+    }
+    ParallelDescriptor::ReduceIntMin(written);
+    if (written == 0) return;
+
+    // Move aside any older directory of the same name, as PreBuildDirectorHierarchy does;
+    // only the I/O rank touches the file system and the others wait until it is done
+    if (ParallelDescriptor::IOProcessor()) {
+        amrex::UtilRenameDirectoryToOld(pending_checkpoint, false);
+        amrex::UtilRename(temporary_checkpoint_name(pending_checkpoint), pending_checkpoint);
+    }
+    ParallelDescriptor::Barrier();
+
+    amrex::Print() << "Checkpoint " << pending_checkpoint << " is complete\n";
+
+    pending_checkpoint.clear();
 }
 
 /**
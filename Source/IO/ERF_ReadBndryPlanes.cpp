@@ -1,11 +1,15 @@
 #include "AMReX_Gpu.H"
 #include "AMReX_ParmParse.H"
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_VisMF.H>
 #include "ERF_ReadBndryPlanes.H"
 #include "IndexDefines.H"
 #include "AMReX_MultiFabUtil.H"
 #include "EOS.H"
 
+#include <algorithm>
+#include <fstream>
+
 using namespace amrex;
 
 /**
@@ -35,6 +39,38 @@ AMREX_FORCE_INLINE IntVect offset(const int face_dir, const int normal)
     return offset;
 }
 
+/**
+ * Read the FABs of each of the FabSets whose VisMF headers are in headers (an empty name
+ * is skipped).  This runs on a thread of its own, so it must not communicate; the FABs
+ * are read in the pinned arena so that they can be copied from on the device.
+ */
+static Vector<Vector<FArrayBox>>
+read_fabs (const Vector<std::string>& headers)
+{
+    Vector<Vector<FArrayBox>> fabs(headers.size());
+    for (int n = 0; n < headers.size(); ++n) {
+        if (headers[n].empty()) continue;
+
+        VisMF::Header hdr;
+        {
+            std::ifstream ifs(headers[n]);
+            ifs >> hdr;
+        }
+        // Only this version writes a header in front of each FAB, which readFrom needs
+        AMREX_ALWAYS_ASSERT(hdr.m_vers == VisMF::Header::Version_v1);
+
+        // The data files are named relative to the directory of the header
+        const std::string dir = headers[n].substr(0, headers[n].rfind('/')+1);
+        for (const auto& fod : hdr.m_fod) {
+            std::ifstream ifs(dir + fod.m_name, std::ios::binary);
+            ifs.seekg(fod.m_head, std::ios::beg);
+            FArrayBox& fab = fabs[n].emplace_back(The_Pinned_Arena());
+            fab.readFrom(ifs);
+        }
+    }
+    return fabs;
+}
+
 /**
  * Function in ReadBndryPlanes class for allocating space
  * for the boundary plane data ERF will need.
@@ -51,9 +87,9 @@ void ReadBndryPlanes::define_level_data(int /*lev*/)
         auto ori = oit();
         if (ori.coordDir() < 2) {
 
-            m_data_n[ori]      = std::make_unique<PlaneVector>();
-            m_data_np1[ori]    = std::make_unique<PlaneVector>();
-            m_data_np2[ori]    = std::make_unique<PlaneVector>();
+            for (auto& data : m_ring_data) {
+                data[ori]      = std::make_unique<PlaneVector>();
+            }
             m_data_interp[ori] = std::make_unique<PlaneVector>();
 
             const auto& lo = domain.loVect();
@@ -65,9 +101,9 @@ void ReadBndryPlanes::define_level_data(int /*lev*/)
             plo[normal] = ori.isHigh() ? hi[normal] + 1 : -1;
             phi[normal] = ori.isHigh() ? hi[normal] + 1 : -1;
             const Box pbx(plo, phi);
-            m_data_n[ori]->push_back(FArrayBox(pbx, ncomp));
-            m_data_np1[ori]->push_back(FArrayBox(pbx, ncomp));
-            m_data_np2[ori]->push_back(FArrayBox(pbx, ncomp));
+            for (auto& data : m_ring_data) {
+                data[ori]->push_back(FArrayBox(pbx, ncomp));
+            }
             m_data_interp[ori]->push_back(FArrayBox(pbx, ncomp));
         }
     }
@@ -82,9 +118,9 @@ void ReadBndryPlanes::define_level_data(int /*lev*/)
 Vector<std::unique_ptr<PlaneVector>>&
 ReadBndryPlanes::interp_in_time(const Real& time)
 {
-    AMREX_ALWAYS_ASSERT(m_tn <= time && time <= m_tnp2);
+    AMREX_ALWAYS_ASSERT(m_ring_times[0] <= time && time <= m_ring_times.back());
 
-    //amrex::Print() << "interp_in_time at time " << time << " given " << m_tn << " " << m_tnp1 << " " << m_tnp2 << std::endl;
+    //amrex::Print() << "interp_in_time at time " << time << " given " << m_ring_times[0] << " ... " << m_ring_times.back() << std::endl;
     //amrex::Print() << "m_tinterp " << m_tinterp << std::endl;
 
     if (time == m_tinterp) {
@@ -96,33 +132,21 @@ ReadBndryPlanes::interp_in_time(const Real& time)
         // We must now interpolate to a new time
         m_tinterp = time;
 
-        if (time < m_tnp1) {
-            for (OrientationIter oit; oit != nullptr; ++oit) {
-                auto ori = oit();
-                if (ori.coordDir() < 2) {
-                    const int nlevels = m_data_n[ori]->size();
-                    for (int lev = 0; lev < nlevels; ++lev) {
-                        const auto& datn   = (*m_data_n[ori])[lev];
-                        const auto& datnp1 = (*m_data_np1[ori])[lev];
-                        auto& dati = (*m_data_interp[ori])[lev];
-                        dati.linInterp<RunOn::Device>(
-                            datn, 0, datnp1, 0, m_tn, m_tnp1, m_tinterp, datn.box(), 0, dati.nComp());
-                    }
-                }
-            }
-        } else {
-            for (OrientationIter oit; oit != nullptr; ++oit) {
-                auto ori = oit();
-                if (ori.coordDir() < 2) {
-                    const int nlevels = m_data_n[ori]->size();
-                    for (int lev = 0; lev < nlevels; ++lev) {
-                        const auto& datnp1 = (*m_data_np1[ori])[lev];
-                        const auto& datnp2 = (*m_data_np2[ori])[lev];
-                        auto& dati = (*m_data_interp[ori])[lev];
-                        dati.linInterp<RunOn::Device>(
-                            datnp1, 0, datnp2, 0, m_tnp1, m_tnp2, m_tinterp, datnp1.box(), 0,
-                            dati.nComp());
-                    }
+        // The time levels s and s+1 bracket time
+        int s = 0;
+        while (s < m_ring_depth-2 && time >= m_ring_times[s+1]) ++s;
+
+        for (OrientationIter oit; oit != nullptr; ++oit) {
+            auto ori = oit();
+            if (ori.coordDir() < 2) {
+                const int nlevels = m_ring_data[s][ori]->size();
+                for (int lev = 0; lev < nlevels; ++lev) {
+                    const auto& datlo = (*m_ring_data[s  ][ori])[lev];
+                    const auto& dathi = (*m_ring_data[s+1][ori])[lev];
+                    auto& dati = (*m_data_interp[ori])[lev];
+                    dati.linInterp<RunOn::Device>(
+                        datlo, 0, dathi, 0, m_ring_times[s], m_ring_times[s+1], m_tinterp, datlo.box(), 0,
+                        dati.nComp());
                 }
             }
         }
@@ -150,6 +174,13 @@ ReadBndryPlanes::ReadBndryPlanes(const Geometry& geom, const Real& rdOcp_in)
     // What folder will the time series of planes be read from
     pp.get("bndry_file", m_filename);
 
+    // How many files to hold at once, and whether to read the next one ahead of time
+    pp.query("bndry_ring_depth", m_ring_depth);
+    pp.query("bndry_prefetch", m_prefetch);
+    if (m_ring_depth < 2) {
+        Abort("erf.bndry_ring_depth must be at least 2");
+    }
+
     is_velocity_read     = 0;
     is_density_read      = 0;
     is_temperature_read  = 0;
@@ -194,9 +225,11 @@ ReadBndryPlanes::ReadBndryPlanes(const Geometry& geom, const Real& rdOcp_in)
     // each pointer (at at given time) has 6 components, one for each orientation
     // TODO: we really only need 4 not 6
     int size = 2*AMREX_SPACEDIM;
-    m_data_n.resize(size);
-    m_data_np1.resize(size);
-    m_data_np2.resize(size);
+    m_ring_data.resize(m_ring_depth);
+    for (auto& data : m_ring_data) {
+        data.resize(size);
+    }
+    m_ring_times.resize(m_ring_depth);
     m_data_interp.resize(size);
 }
 
@@ -260,6 +293,16 @@ void ReadBndryPlanes::read_time_file()
         ParallelDescriptor::IOProcessorNumber(),
         ParallelDescriptor::Communicator());
 
+    // We interpolate between two files, but can't hold more files than there are
+    if (time_file_length < 2) {
+        Abort("The time file " + m_time_file + " must list at least two boundary files");
+    }
+    if (m_ring_depth > time_file_length) {
+        m_ring_depth = time_file_length;
+        m_ring_data.resize(m_ring_depth);
+        m_ring_times.resize(m_ring_depth);
+    }
+
     // Allocate data we will need -- for now just at one level
     int lev = 0;
     define_level_data(lev);
@@ -292,51 +335,100 @@ void ReadBndryPlanes::read_input_files(Real time, Real dt,
     BndryRegister bndryn(ba, dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
     bndryn.setVal(1.0e13);
 
-    // The first time we enter this routine we read the first three files
+    // The first time we enter this routine we read the first m_ring_depth files
     if (last_file_read == -1)
     {
         int idx_init = 0;
-        read_file(idx_init,m_data_n,m_bc_extdir_vals);
         read_file(idx_init,m_data_interp,m_bc_extdir_vals); // We want to start with this filled
-        m_tn = m_in_times[idx_init];
 
-        idx_init = 1;
-        read_file(idx_init,m_data_np1,m_bc_extdir_vals);
-        m_tnp1 = m_in_times[idx_init];
-
-        idx_init = 2;
-        read_file(idx_init,m_data_np2,m_bc_extdir_vals);
-        m_tnp2 = m_in_times[idx_init];
+        for (int s = 0; s < m_ring_depth; ++s) {
+            read_file(s,m_ring_data[s],m_bc_extdir_vals);
+            m_ring_times[s] = m_in_times[s];
+        }
+        last_file_read = m_ring_depth-1;
 
-        last_file_read = idx_init;
+        start_prefetch(last_file_read+1);
     }
 
     // Compute the index such that time falls between times[idx] and times[idx+1]
     const int idx = closest_index(m_in_times, time);
 
-    // Now we need to read another file
-    if (idx >= last_file_read-1 && last_file_read != m_in_times.size()-1) {
+    // Now we need to read another file, until the first one we hold is the one at idx
+    while (last_file_read-m_ring_depth+1 < idx && last_file_read != m_in_times.size()-1) {
         int new_read = last_file_read+1;
 
         // We need to change which data the pointers point to before we read in the new data
-        // This doesn't actually move the data, just swaps the pointers
+        // This doesn't actually move the data, just rotates the pointers
+        std::rotate(m_ring_data.begin() , m_ring_data.begin()+1 , m_ring_data.end());
+        std::rotate(m_ring_times.begin(), m_ring_times.begin()+1, m_ring_times.end());
+
+        // Set the time corresponding to the post-rotation pointers
+        m_ring_times.back() = m_in_times[new_read];
+
+        finish_prefetch();
+        read_file(new_read,m_ring_data.back(),m_bc_extdir_vals);
+        last_file_read = new_read;
+
+        // Start reading the file we will need next while we use these
+        start_prefetch(last_file_read+1);
+    }
+
+    AMREX_ASSERT(time    >= m_ring_times[0] && time    <= m_ring_times.back());
+    if (time+dt > m_ring_times.back()) {
+        Abort("A time step spans more than erf.bndry_ring_depth-1 intervals between boundary files;"
+              " increase erf.bndry_ring_depth");
+    }
+}
+
+/**
+ * Function in ReadBndryPlanes to start reading the FABs of a time index on a thread of its
+ * own, so that read_file only has to copy them.  The boundary data all live on one rank,
+ * which is the only one that reads them; the others just note the index.
+ *
+ * @param idx Specifies the index corresponding to the timestep we will want next
+ */
+void ReadBndryPlanes::start_prefetch(const int idx)
+{
+    if (!m_prefetch || idx >= m_in_times.size()) return;
+
+    finish_prefetch();
+    m_prefetch_fabs.clear();
+    m_prefetch_idx = idx;
+
+    const Box& domain = m_geom.Domain();
+    BoxArray ba(domain);
+    DistributionMapping dm{ba};
+    if (dm[0] != ParallelDescriptor::MyProc()) return;
+
+    const int t_step = m_in_timesteps[idx];
+    const std::string chkname1 = m_filename + Concatenate("/bndry_output", t_step);
+
+    const std::string level_prefix = "Level_";
+    const int lev = 0;
+
+    Vector<std::string> headers(m_var_names.size()*2*AMREX_SPACEDIM);
+    for (int ivar = 0; ivar < m_var_names.size(); ivar++)
+    {
+        std::string filename1 = MultiFabFileFullPrefix(lev, chkname1, level_prefix, m_var_names[ivar]);
         for (OrientationIter oit; oit != nullptr; ++oit) {
             auto ori = oit();
-            std::swap(m_data_n[ori]  ,m_data_np1[ori]);
-            std::swap(m_data_np1[ori],m_data_np2[ori]);
+            if (ori.coordDir() < 2) {
+                headers[ivar*2*AMREX_SPACEDIM + ori] = Concatenate(filename1 + '_', ori, 1) + "_H";
+            }
         }
+    }
 
-        // Set the times corresponding to the post-swap pointers
-        m_tn   = m_tnp1;
-        m_tnp1 = m_tnp2;
-        m_tnp2 = m_in_times[new_read];
+    m_prefetch_done = std::async(std::launch::async, read_fabs, headers);
+}
 
-        read_file(new_read,m_data_np2,m_bc_extdir_vals);
-        last_file_read = new_read;
+/**
+ * Function in ReadBndryPlanes to wait for the FABs being read by start_prefetch.
+ */
+void ReadBndryPlanes::finish_prefetch()
+{
+    if (m_prefetch_done.valid()) {
+        m_prefetch_fabs = m_prefetch_done.get();
     }
-
-    AMREX_ASSERT(time    >= m_tn && time    <= m_tnp2);
-    AMREX_ASSERT(time+dt >= m_tn && time+dt <= m_tnp2);
 }
 
 /**
@@ -360,6 +452,13 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
     BoxArray ba(domain);
     DistributionMapping dm{ba};
 
+    // If this index was read in the background, the rank that owns the data has its FABs,
+    //    so no rank reads the files here
+    const bool prefetched = (idx == m_prefetch_idx);
+    if (prefetched) {
+        finish_prefetch();
+    }
+
     GpuArray<GpuArray<Real, AMREX_SPACEDIM*2>,
                                                  AMREX_SPACEDIM+NVAR> l_bc_extdir_vals_d;
 
@@ -434,8 +533,17 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
           auto ori = oit();
           if (ori.coordDir() < 2) {
 
-            std::string facename1 = Concatenate(filename1 + '_', ori, 1);
-            bndry[ori].read(facename1);
+            if (prefetched) {
+                const auto& fabs = m_prefetch_fabs[ivar*2*AMREX_SPACEDIM + ori];
+                for (MFIter mfi(bndry[ori].boxArray(), bndry[ori].DistributionMap()); mfi.isValid(); ++mfi) {
+                    const FArrayBox& src = fabs[mfi.index()];
+                    AMREX_ALWAYS_ASSERT(src.box() == bndry[ori][mfi].box() && src.nComp() == ncomp);
+                    bndry[ori][mfi].template copy<RunOn::Device>(src);
+                }
+            } else {
+                std::string facename1 = Concatenate(filename1 + '_', ori, 1);
+                bndry[ori].read(facename1);
+            }
 
             const int normal = ori.coordDir();
             const IntVect v_offset = offset(ori.faceDir(), normal);
@@ -537,4 +645,10 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
           } // coordDir < 2
         } // ori
     } // var_name
+
+    if (prefetched) {
+        Gpu::streamSynchronize();
+        m_prefetch_fabs.clear();
+        m_prefetch_idx = -1;
+    }
 }
@@ -298,19 +298,19 @@ ERF::derive_stress_profiles(Gpu::HostVector<Real>& h_avg_tau11, Gpu::HostVector<
         const Array4<Real>& fab_arr = mf_out.array(mfi);
 
         // NOTE: These are from the last RK stage...
-        const Array4<const Real>& tau11_arr = Tau11_lev[lev]->const_array(mfi);
-        const Array4<const Real>& tau12_arr = Tau12_lev[lev]->const_array(mfi);
-        const Array4<const Real>& tau13_arr = Tau13_lev[lev]->const_array(mfi);
-        const Array4<const Real>& tau22_arr = Tau22_lev[lev]->const_array(mfi);
-        const Array4<const Real>& tau23_arr = Tau23_lev[lev]->const_array(mfi);
-        const Array4<const Real>& tau33_arr = Tau33_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau11_arr = Tau11_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau12_arr = Tau12_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau13_arr = Tau13_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau22_arr = Tau22_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau23_arr = Tau23_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& tau33_arr = Tau33_lev[lev]->const_array(mfi);
 
         // These should be re-calculated during ERF_slow_rhs_post
         // -- just vertical SFS kinematic heat flux for now
-        //const Array4<const Real>& hfx1_arr = SFS_hfx1_lev[lev]->const_array(mfi);
-        //const Array4<const Real>& hfx2_arr = SFS_hfx2_lev[lev]->const_array(mfi);
-        const Array4<const Real>& hfx3_arr = SFS_hfx3_lev[lev]->const_array(mfi);
-        const Array4<const Real>& diss_arr = SFS_diss_lev[lev]->const_array(mfi);
+        //const Array4<const AuxReal>& hfx1_arr = SFS_hfx1_lev[lev]->const_array(mfi);
+        //const Array4<const AuxReal>& hfx2_arr = SFS_hfx2_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& hfx3_arr = SFS_hfx3_lev[lev]->const_array(mfi);
+        const Array4<const AuxReal>& diss_arr = SFS_diss_lev[lev]->const_array(mfi);
 
         ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
         {
@@ -10,6 +10,9 @@ using namespace amrex;
 void
 ERF::WriteNCCheckpointFile () const
 {
+    // The NetCDF library may not be used from two threads at once
+    finish_wrfbdy_prefetch();
+
     // checkpoint file name, e.g., chk00010
     const std::string& checkpointname = amrex::Concatenate(check_file,istep[0],5);
 
@@ -218,19 +221,19 @@ ERF::ReadNCCheckpointFile ()
     {
 
         MultiFab cons(grids[lev],dmap[lev],Cons::NumVars,0);
-        WriteNCMultiFab(cons, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(cons, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
         MultiFab::Copy(vars_new[lev][Vars::cons],cons,0,0,Cons::NumVars,0);
 
         MultiFab xvel(convert(grids[lev],IntVect(1,0,0)),dmap[lev],1,0);
-        WriteNCMultiFab(xvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(xvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "XFace"));
         MultiFab::Copy(vars_new[lev][Vars::xvel],xvel,0,0,1,0);
 
         MultiFab yvel(convert(grids[lev],IntVect(0,1,0)),dmap[lev],1,0);
-        WriteNCMultiFab(yvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(yvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "YFace"));
         MultiFab::Copy(vars_new[lev][Vars::yvel],yvel,0,0,1,0);
 
         MultiFab zvel(convert(grids[lev],IntVect(0,0,1)),dmap[lev],1,0);
-        WriteNCMultiFab(zvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(zvel, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "ZFace"));
         MultiFab::Copy(vars_new[lev][Vars::zvel],zvel,0,0,1,0);
 
         // Copy from new into old just in case
@@ -66,6 +66,9 @@ ERF::writeToNCColumnFile(const int lev,
                          const std::string& colfile_name, const Real xloc, const Real yloc,
                          const Real cumtime)
 {
+  // The NetCDF library may not be used from two threads at once
+  finish_wrfbdy_prefetch();
+
   //
   // This routine assumes that we can grab the whole column of data from the MultiFabs at
   //     a single level, "lev".  This assumption is true as long as we don't refine only
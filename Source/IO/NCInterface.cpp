@@ -458,6 +458,12 @@ void NCVar::par_access(const int cmode) const
     check_nc_error(nc_var_par_access(ncid, varid, cmode));
 }
 
+void NCVar::def_deflate(const bool shuffle, const int level) const
+{
+    check_nc_error(nc_def_var_deflate(
+        ncid, varid, shuffle ? NC_SHUFFLE : NC_NOSHUFFLE, (level > 0) ? 1 : 0, level));
+}
+
 std::string NCGroup::name() const
 {
     size_t nlen;
@@ -14,80 +14,101 @@
 
 #include "ERF.H"
 #include "NCInterface.H"
+#include "NCAggregate.H"
+#include "NCCompression.H"
 #include "NCPlotFile.H"
 #include "IndexDefines.H"
 
 using namespace amrex;
 
-void
-ERF::ReadNCMultiFab(FabArray<FArrayBox> &mf,
-                    const std::string  &mf_name,
-                    int /*coordinatorProc*/,
-                    int /*allow_empty_mf*/) {
-
-    const std::string& FullPath = amrex::Concatenate(check_file,istep[0],5);
-
-    amrex::Print() << "Reading MultiFab NetCDF checkpoint file to path: " << FullPath << "\n";
-
-    if (amrex::ParallelDescriptor::IOProcessor())
+namespace {
+    // The file that holds run m of the boxes when a MultiFab is written to nfiles files
+    std::string data_file_name (const std::string& name, int m, int nfiles)
     {
-      static const std::string Suffix(mf_name);
-      auto ncf = ncutils::NCFile::create(FullPath+Suffix, NC_CLOBBER | NC_NETCDF4);
-
-      // int num_pts = static_cast<int>(ncf.dim("num_points").len());
-      int ncomp   = static_cast<int>(ncf.dim("num_componts").len());
-      int nbox    = static_cast<int>(ncf.dim("num_box").len());
-      int ngrow   = 0;
-
-      BoxList boxlist;
-      amrex::Vector<std::string> plt_var_names;
-
-      for (int nb(0); nb < nbox; ++nb) {
-          amrex::IntVect smallend(AMREX_SPACEDIM);
-          amrex::IntVect bigend(AMREX_SPACEDIM);
-          amrex::IntVect btype(AMREX_SPACEDIM);
-
-          long unsigned int nbb = static_cast<unsigned long int>(nb);
-          ncf.var("SmallEnd").get(smallend.begin(), {0}, {nbb, AMREX_SPACEDIM});
-          ncf.var("BigEnd"  ).get(bigend.begin()  , {0}, {nbb, AMREX_SPACEDIM});
-          ncf.var("BoxType" ).get(btype.begin()   , {0}, {nbb, AMREX_SPACEDIM});
-
-          std::stringstream ss;
-          ss << btype;
-          std::string typ_name = ss.str();
-          plt_var_names.push_back(typ_name+"_"+std::to_string(nb));
+        return (nfiles == 1) ? name + "_Data.nc"
+                             : name + amrex::Concatenate("_Data_", m, 5) + ".nc";
+    }
+}
 
-          boxlist.push_back(amrex::Box(smallend, bigend, btype));
-      }
+/**
+ * Read into mf, which must already be defined on the BoxArray it was written with, the
+ * MultiFab that WriteNCMultiFab wrote under name.  The number of files is taken from the
+ * first of them; file m holds run m of the boxes, which is read by the rank that the same
+ * aggregation would give it to and then copied into the DistributionMapping of mf.
+ */
+void
+ERF::ReadNCMultiFab (FabArray<FArrayBox> &mf,
+                     const std::string  &name,
+                     int /*coordinatorProc*/,
+                     int /*allow_empty_mf*/)
+{
+    BL_PROFILE("ERF::ReadNCMultiFab()");
+
+    amrex::Print() << "Reading MultiFab NetCDF checkpoint data from: " << name << "\n";
+
+    int nfiles = 1;
+    if (ParallelDescriptor::IOProcessor() && !amrex::FileExists(data_file_name(name, 0, 1))) {
+        auto ncf = ncutils::NCFile::open(data_file_name(name, 0, 2), NC_NOWRITE);
+        std::vector<int> num_files;
+        ncf.get_attr("num_files", num_files);
+        nfiles = num_files[0];
+    }
+    ParallelDescriptor::Bcast(&nfiles, 1, ParallelDescriptor::IOProcessorNumber());
+
+    const BoxArray& ba = mf.boxArray();
+    const IntVect& ngvect = mf.nGrowVect();
+    const Vector<int> run = ncaggregate::box_runs(ba, nfiles);
+    FabArray<FArrayBox> fab(ba, ncaggregate::make_dm(ba, nfiles),
+                            mf.nComp(), ngvect, MFInfo(), FArrayBoxFactory());
+
+    // The files that hold the boxes of this rank, in order
+    Vector<int> my_files;
+    for (amrex::MFIter mfi(fab); mfi.isValid(); ++mfi) {
+        if (my_files.empty() || my_files.back() != run[mfi.index()]) {
+            my_files.push_back(run[mfi.index()]);
+        }
+    }
 
-      BoxArray boxarray(boxlist);
-      DistributionMapping dm(boxarray);
-      mf.define(boxarray, dm, ncomp, ngrow, MFInfo(), FArrayBoxFactory());
+    for (int m : my_files) {
+        auto ncf = ncutils::NCFile::open(data_file_name(name, m, nfiles), NC_NOWRITE);
+        for (amrex::MFIter mfi(fab); mfi.isValid(); ++mfi) {
+            if (run[mfi.index()] != m) continue;
 
-      for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
-           auto ncomp_mf   = mf.nComp();
-           auto num_pts_mf  = static_cast<long unsigned int>(mf.get(mfi).numPts());
+            auto ncomp_mf    = fab.nComp();
+            auto num_pts_mf  = static_cast<long unsigned int>(fab.get(mfi).numPts());
+            std::string comp_name = std::to_string(mfi.index());
 
-           for (int k(0); k < ncomp_mf; ++k) {
-               auto dataPtr = mf.get(mfi).dataPtr(k);
-               ncf.var(plt_var_names[mfi.index()*ncomp_mf+k]).get(dataPtr, {0}, {num_pts_mf});
+            for (int k(0); k < ncomp_mf; ++k) {
+                auto dataPtr = fab.get(mfi).dataPtr(k);
+                ncf.var("var_"+comp_name+"_"+std::to_string(k)).get(dataPtr, {0}, {num_pts_mf});
             }
-      }
-
+        }
+    }
 
-   }
+    mf.ParallelCopy(fab, 0, 0, mf.nComp(), ngvect, ngvect);
 }
 
 
 void
-ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
+ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab_in,
                       const std::string& name,
                       bool /*set_ghost*/) const {
 
-    if (amrex::ParallelDescriptor::IOProcessor())
+    // Gather the data onto the aggregators, each of which writes its contiguous range of
+    //     boxes to a file of its own.  By default there is just one, the I/O rank, which
+    //     then holds a copy of the whole MultiFab while it writes
+    const int naggr = (nc_num_aggregators > 0) ? ncaggregate::num_aggregators(nc_num_aggregators) : 1;
+    const IntVect& ngvect = fab_in.nGrowVect();
+    FabArray<FArrayBox> fab(fab_in.boxArray(), ncaggregate::make_dm(fab_in.boxArray(), naggr),
+                            fab_in.nComp(), ngvect, MFInfo(), FArrayBoxFactory());
+    fab.ParallelCopy(fab_in, 0, 0, fab_in.nComp(), ngvect, ngvect);
+
+    const int iagg = ncaggregate::aggregator_index(ParallelDescriptor::MyProc(), naggr);
+    if (iagg >= 0)
     {
-      static const std::string Suffix{"_Data.nc"};
-      auto ncf = ncutils::NCFile::create(name+Suffix, NC_CLOBBER | NC_NETCDF4);
+      const std::string FileName = data_file_name(name, iagg, naggr);
+      const Real t_start = amrex::second();
+      auto ncf = ncutils::NCFile::create(FileName, NC_CLOBBER | NC_NETCDF4);
 
       //
       // use separate name scope for data output
@@ -98,7 +119,7 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
         const std::string ndim_name   = "num_dimension";
         const std::string nvar_name   = "num_variables";
 
-        // setup the plot variable names
+        // setup the plot variable names; the boxes are named by their index in the BoxArray
         amrex::Vector<std::string> plt_var_names;
         amrex::Vector<std::string> npts_names;
         amrex::Vector<int> num_pts;
@@ -113,21 +134,23 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
            }
         }
 
-        auto box_array = fab.boxArray();
         auto nvar      = plt_var_names.size();
         auto nbox      = fab.local_size();
 
         amrex::Vector<std::string> lo_names;
         amrex::Vector<std::string> hi_names;
         amrex::Vector<std::string> typ_names;
-        for (int nb(0); nb < nbox; ++nb) {
-           lo_names.push_back("SmallEnd_"+std::to_string(nb));
-           hi_names.push_back("BigEnd_"+std::to_string(nb));
-           typ_names.push_back("BoxType_"+std::to_string(nb));
+        for (amrex::MFIter mfi(fab); mfi.isValid(); ++mfi) {
+           std::string box_name = std::to_string(mfi.index());
+           lo_names.push_back("SmallEnd_"+box_name);
+           hi_names.push_back("BigEnd_"+box_name);
+           typ_names.push_back("BoxType_"+box_name);
         }
 
         ncf.enter_def_mode();
         ncf.put_attr("title", "ERF NetCDF MultiFab Data");
+        ncf.put_attr("num_files", std::vector<int>{naggr});
+        ncf.put_attr("file_index", std::vector<int>{iagg});
 
         ncf.def_dim(ndim_name, AMREX_SPACEDIM);
         ncf.def_dim(nb_name, nbox);
@@ -135,7 +158,8 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
 
         for (int k = 0; k < nvar; ++k) {
           ncf.def_dim(npts_names[k], num_pts[k]);
-          ncf.def_var(plt_var_names[k], ncutils::NCDType::Real, {npts_names[k]});
+          auto nc_var = ncf.def_var(plt_var_names[k], ncutils::NCDType::Real, {npts_names[k]});
+          nccompress::def_compression(nc_var, nc_check_deflate);
         }
 
         for (int nb = 0; nb < nbox; ++nb) {
@@ -155,17 +179,26 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
             amrex::IntVect bigend   = box.bigEnd();
             amrex::IntVect itype    = box.type();
 
-            auto index = static_cast<long unsigned int>(mfi.index());
-            ncf.var(lo_names[mfi.index()] ).put(smallend.begin(), {index, 0}, {1, AMREX_SPACEDIM});
-            ncf.var(hi_names[mfi.index()] ).put(bigend.begin()  , {index, 0}, {1, AMREX_SPACEDIM});
-            ncf.var(typ_names[mfi.index()]).put(itype.begin()   , {index, 0}, {1, AMREX_SPACEDIM});
+            const int li = mfi.LocalIndex();
+            auto index = static_cast<long unsigned int>(li);
+            ncf.var(lo_names[li] ).put(smallend.begin(), {index, 0}, {1, AMREX_SPACEDIM});
+            ncf.var(hi_names[li] ).put(bigend.begin()  , {index, 0}, {1, AMREX_SPACEDIM});
+            ncf.var(typ_names[li]).put(itype.begin()   , {index, 0}, {1, AMREX_SPACEDIM});
 
             for (int k(0); k < ncomp_mf; ++k) {
                 auto dataPtr = fab.get(mfi).dataPtr(k);
-                ncf.var(plt_var_names[mfi.index()*ncomp_mf+k]).put(dataPtr, {0}, {static_cast<long unsigned int>(num_pts_mf)});
+                ncf.var(plt_var_names[li*ncomp_mf+k]).put(dataPtr, {0}, {static_cast<long unsigned int>(num_pts_mf)});
              }
         }
         ncf.close();
+
+        if (nc_check_deflate > 0) {
+            double raw_bytes = 0.0;
+            for (int k = 0; k < nvar; ++k) {
+                raw_bytes += static_cast<double>(num_pts[k]) * sizeof(Real);
+            }
+            nccompress::report(FileName, raw_bytes, amrex::second() - t_start);
+        }
       }
    }
 }
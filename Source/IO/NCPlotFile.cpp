@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -13,6 +14,8 @@
 
 #include "ERF.H"
 #include "NCInterface.H"
+#include "NCAggregate.H"
+#include "NCCompression.H"
 #include "NCPlotFile.H"
 #include "IndexDefines.H"
 
@@ -24,6 +27,9 @@ ERF::writeNCPlotFile(int lev, int which_subdomain, const std::string& dir,
                      const Vector<std::string> &plot_var_names,
                      const Vector<int> level_steps, const Real time) const
 {
+     // The NetCDF library may not be used from two threads at once
+     finish_wrfbdy_prefetch();
+
      // get the processor number
      int iproc = amrex::ParallelContext::MyProcAll();
      int nproc = amrex::ParallelDescriptor::NProcs();
@@ -46,6 +52,8 @@ ERF::writeNCPlotFile(int lev, int which_subdomain, const std::string& dir,
 
      amrex::Print() << "Writing level " << lev << " NetCDF plot file " << FullPath << std::endl;
 
+     const Real t_start = amrex::second();
+
      // open netcdf file to write data
      auto ncf = ncutils::NCFile::create_par(FullPath, NC_NETCDF4 | NC_MPIIO,
                                             amrex::ParallelContext::CommunicatorSub(), MPI_INFO_NULL);
@@ -114,7 +122,8 @@ ERF::writeNCPlotFile(int lev, int which_subdomain, const std::string& dir,
      ncf.def_var("z_grid", NC_FLOAT, {np_name});
 
      for (int i = 0; i < plot_var_names.size(); i++) {
-         ncf.def_var(plot_var_names[i], NC_FLOAT, {np_name});
+         auto nc_plot_var = ncf.def_var(plot_var_names[i], NC_FLOAT, {np_name});
+         nccompress::def_compression(nc_plot_var, nc_plot_deflate);
      }
 
      ncf.exit_def_mode();
@@ -222,24 +231,113 @@ ERF::writeNCPlotFile(int lev, int which_subdomain, const std::string& dir,
        }
    }
 
-   size_t nfai = 0;
-   long unsigned numpts = 0;
    const int ncomp = plotMF[lev]->nComp();
-   for (amrex::MFIter fai(*plotMF[lev]); fai.isValid(); ++fai) {
-       auto box = fai.validbox();
-       if (subdomain.contains(box)) {
-           long unsigned diff = nfai*numpts;
-           for(auto ip = 1; ip <= iproc; ++ip) diff += offset[ip-1];
-           numpts = box.numPts();
-
-           for (int k(0); k < ncomp; ++k) {
-              auto data = plotMF[lev]->get(fai).dataPtr(k);
-              auto nc_plot_var = ncf.var(plot_var_names[k]);
-              nc_plot_var.par_access(NC_INDEPENDENT);
-              nc_plot_var.put(data, {diff}, {numpts});
-          }
-          nfai++;
+
+   // The boxes of this rank to write, and where their data go in the file.  With
+   //     erf.nc_num_aggregators > 0 the boxes in the subdomain are first gathered onto that
+   //     many ranks, each of which then holds a contiguous range of the file.
+   const MultiFab* data_mf = plotMF[lev];
+   MultiFab agg_mf;
+   Vector<int> local_boxes;
+   Vector<long unsigned> starts;
+   Vector<long unsigned> counts;
+   if (nc_num_aggregators > 0) {
+       const BoxArray& ba = plotMF[lev]->boxArray();
+       BoxList bl;
+       Vector<long unsigned> file_offset;
+       long unsigned npts_before = 0;
+       for (int i = 0; i < ba.size(); ++i) {
+           if (subdomain.contains(ba[i])) {
+               bl.push_back(ba[i]);
+               file_offset.push_back(npts_before);
+               npts_before += ba[i].numPts();
+           }
+       }
+       BoxArray ba_agg(std::move(bl));
+       agg_mf.define(ba_agg, ncaggregate::make_dm(ba_agg, ncaggregate::num_aggregators(nc_num_aggregators)),
+                     ncomp, 0);
+       agg_mf.ParallelCopy(*plotMF[lev], 0, 0, ncomp);
+       data_mf = &agg_mf;
+
+       for (amrex::MFIter mfi(agg_mf); mfi.isValid(); ++mfi) {
+           local_boxes.push_back(mfi.index());
+           starts.push_back(file_offset[mfi.index()]);
+           counts.push_back(ba_agg[mfi.index()].numPts());
+       }
+   } else {
+       size_t nfai = 0;
+       long unsigned numpts = 0;
+       for (amrex::MFIter fai(*plotMF[lev]); fai.isValid(); ++fai) {
+           auto box = fai.validbox();
+           if (subdomain.contains(box)) {
+               long unsigned diff = nfai*numpts;
+               for(auto ip = 1; ip <= iproc; ++ip) diff += offset[ip-1];
+               numpts = box.numPts();
+
+               local_boxes.push_back(fai.index());
+               starts.push_back(diff);
+               counts.push_back(numpts);
+               nfai++;
+           }
+       }
+   }
+
+   // Boxes that are next to each other in the file are written with a single request
+   Vector<int> run_begin;
+   for (int n = 0; n < local_boxes.size(); ++n) {
+       if (n == 0 || starts[n] != starts[n-1] + counts[n-1]) run_begin.push_back(n);
+   }
+   const int nruns = static_cast<int>(run_begin.size());
+   run_begin.push_back(static_cast<int>(local_boxes.size()));
+
+   // The HDF5 filters that compress a variable need every rank to take part in each
+   //     write to it, so when compressing, ranks with fewer runs make empty writes
+   const bool l_compress = (nc_plot_deflate > 0);
+   int nwrites = nruns;
+   if (l_compress) {
+       ParallelAllReduce::Max(nwrites, amrex::ParallelContext::CommunicatorSub());
+   }
+
+   std::vector<Real> wdata;
+   for (int k(0); k < ncomp; ++k) {
+       auto nc_plot_var = ncf.var(plot_var_names[k]);
+       nc_plot_var.par_access(l_compress ? NC_COLLECTIVE : NC_INDEPENDENT);
+
+       auto it = nc_plot_abs_error.find(plot_var_names[k]);
+       const Real q = nccompress::quantization_step((it != nc_plot_abs_error.end()) ? it->second : 0.0);
+
+       for (int r = 0; r < nwrites; ++r) {
+           if (r < nruns) {
+               const int b0 = run_begin[r];
+               const int b1 = run_begin[r+1];
+               const Real* data = (*data_mf)[local_boxes[b0]].dataPtr(k);
+               long unsigned npts = counts[b0];
+               if (b1 - b0 > 1 || q > 0.0) {
+                   npts = starts[b1-1] + counts[b1-1] - starts[b0];
+                   wdata.resize(npts);
+                   for (int n = b0; n < b1; ++n) {
+                       const Real* src = (*data_mf)[local_boxes[n]].dataPtr(k);
+                       Real* dst = wdata.data() + (starts[n] - starts[b0]);
+                       if (q > 0.0) {
+                           nccompress::quantize(src, dst, counts[n], q);
+                       } else {
+                           std::copy(src, src + counts[n], dst);
+                       }
+                   }
+                   data = wdata.data();
+               }
+               nc_plot_var.put(data, {starts[b0]}, {npts});
+           } else {
+               const Real none = 0.0;
+               nc_plot_var.put(&none, {0}, {0});
+           }
        }
    }
    ncf.close();
+
+   if ((l_compress || !nc_plot_abs_error.empty()) && ParallelDescriptor::IOProcessor()) {
+       // The grid coordinates and the plot variables are all stored as floats
+       const double raw_bytes = static_cast<double>(num_pts) * (n_data_items + AMREX_SPACEDIM) * sizeof(float);
+       nccompress::report(FullPath, raw_bytes, amrex::second() - t_start);
+   }
 }
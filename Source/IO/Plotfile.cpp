@@ -5,8 +5,49 @@
 #include "TerrainMetrics.H"
 #include "ERF_Constants.H"
 
+#include <condition_variable>
+#include <mutex>
+
 using namespace amrex;
 
+namespace {
+
+// The number of plotfiles handed to the AsyncOut thread that it has not finished writing
+std::mutex              inflight_mutex;
+std::condition_variable inflight_cv;
+int                     inflight_plotfiles = 0;
+
+// Wait until fewer than max_inflight plotfiles are being written (no limit if max_inflight <= 0)
+void
+wait_for_inflight_plotfiles (int max_inflight)
+{
+    if (max_inflight <= 0) return;
+    BL_PROFILE("wait_for_inflight_plotfiles()");
+    std::unique_lock<std::mutex> lock(inflight_mutex);
+    inflight_cv.wait(lock, [=] () { return inflight_plotfiles < max_inflight; });
+}
+
+// Count a plotfile whose writes have just been submitted to the AsyncOut thread; that
+// thread runs its tasks in order, so the plotfile is on disk once the task we submit here
+// has run
+void
+submit_inflight_plotfile ()
+{
+    {
+        std::lock_guard<std::mutex> lock(inflight_mutex);
+        ++inflight_plotfiles;
+    }
+    AsyncOut::Submit([] () {
+        {
+            std::lock_guard<std::mutex> lock(inflight_mutex);
+            --inflight_plotfiles;
+        }
+        inflight_cv.notify_all();
+    });
+}
+
+} // namespace
+
 void
 ERF::setPlotVariables (const std::string& pp_plot_var_names, Vector<std::string>& plot_var_names)
 {
@@ -90,6 +131,14 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
     const Vector<std::string> varnames = PlotFileVarNames(plot_var_names);
     const int ncomp_mf = varnames.size();
 
+    // With amrex.async_out the plotfile is written by a background thread from a copy of
+    //     mf and mf_nd while we go on stepping; we bound the memory held by these copies
+    //     by waiting here if too many plotfiles are still being written
+    const bool l_async = AsyncOut::UseAsyncOut() && (plotfile_type == "amrex");
+    if (l_async) {
+        wait_for_inflight_plotfiles(plot_max_inflight);
+    }
+
     // We fillpatch here because some of the derived quantities require derivatives
     //     which require ghost cells to be filled
     for (int lev = 0; lev <= finest_level; ++lev) {
@@ -767,6 +816,16 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
     else if (which == 2)
        plotfilename = Concatenate(plot_file_2, istep[0], 5);
 
+    // With erf.plot_float the FABs of a native plotfile are written as 32-bit floats, half
+    //     the size of the default; the format is global to FArrayBox, so we put it back once
+    //     the plotfile is written so that checkpoints are still written in full precision.
+    //     The AMReX output thread reads the format when it gets to the write, so this is
+    //     not done with amrex.async_out
+    const FABio::Format fab_format = FArrayBox::getFormat();
+    if (plot_float && !l_async && plotfile_type == "amrex") {
+        FArrayBox::setFormat(FABio::FAB_NATIVE_32);
+    }
+
     if (finest_level == 0)
     {
         if (plotfile_type == "amrex") {
@@ -795,9 +854,14 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
                                                Geom(), t_new[0], istep, refRatio());
             }
             writeJobInfo(plotfilename);
+            if (l_async) submit_inflight_plotfile();
 #ifdef ERF_USE_HDF5
         } else if (plotfile_type == "hdf5" || plotfile_type == "HDF5") {
             amrex::Print() << "Writing plotfile " << plotfilename+"d01.h5" << "\n";
+#ifdef ERF_USE_NETCDF
+            // NetCDF-4 reads the wrfbdy file through HDF5, which may not be used from two threads at once
+            finish_wrfbdy_prefetch();
+#endif
             WriteMultiLevelPlotfileHDF5(plotfilename, finest_level+1,
                                         GetVecOfConstPtrs(mf),
                                         varnames,
@@ -868,6 +932,7 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
             WriteMultiLevelPlotfile(plotfilename, finest_level+1, GetVecOfConstPtrs(mf2), varnames,
                                            g2, t_new[0], istep, rr);
             writeJobInfo(plotfilename);
+            if (l_async) submit_inflight_plotfile();
 #ifdef ERF_USE_NETCDF
         } else if (plotfile_type == "netcdf" || plotfile_type == "NetCDF") {
              for (int lev = 0; lev <= finest_level; ++lev) {
@@ -878,6 +943,8 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
 #endif
         }
     } // end multi-level
+
+    FArrayBox::setFormat(fab_format);
 }
 
 void
@@ -915,6 +982,11 @@ ERF::WriteMultiLevelPlotfileWithTerrain (const std::string& plotfilename, int nl
             boxArrays[level] = mf[level]->boxArray();
         }
 
+        // The header may be written by the AsyncOut thread after a regrid, so it is
+        //     written from copies of the geometry and refinement ratios
+        Vector<Geometry> level_geom(geom.begin(), geom.begin()+nlevels);
+        Vector<IntVect>  level_ref_ratio(ref_ratio.begin(), ref_ratio.begin()+(nlevels-1));
+
         auto f = [=]() {
             VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
             std::string HeaderFileName(plotfilename + "/Header");
@@ -924,7 +996,8 @@ ERF::WriteMultiLevelPlotfileWithTerrain (const std::string& plotfilename, int nl
                                                     std::ofstream::trunc |
                                                     std::ofstream::binary);
             if( ! HeaderFile.good()) FileOpenFailed(HeaderFileName);
-            WriteGenericPlotfileHeaderWithTerrain(HeaderFile, nlevels, boxArrays, varnames,
+            WriteGenericPlotfileHeaderWithTerrain(HeaderFile, nlevels, boxArrays,
+                                                  level_geom, level_ref_ratio, varnames,
                                                   time, level_steps, versionName,
                                                   levelPrefix, mfPrefix);
         };
@@ -969,17 +1042,22 @@ void
 ERF::WriteGenericPlotfileHeaderWithTerrain (std::ostream &HeaderFile,
                                             int nlevels,
                                             const Vector<BoxArray> &bArray,
+                                            const Vector<Geometry> &level_geom,
+                                            const Vector<IntVect> &level_ref_ratio,
                                             const Vector<std::string> &varnames,
                                             Real time,
                                             const Vector<int> &level_steps,
                                             const std::string &versionName,
                                             const std::string &levelPrefix,
-                                            const std::string &mfPrefix) const
+                                            const std::string &mfPrefix)
 {
         BL_ASSERT(nlevels <= bArray.size());
-        BL_ASSERT(nlevels <= ref_ratio.size()+1);
+        BL_ASSERT(nlevels <= level_geom.size());
+        BL_ASSERT(nlevels <= level_ref_ratio.size()+1);
         BL_ASSERT(nlevels <= level_steps.size());
 
+        const int flev = nlevels-1;
+
         HeaderFile.precision(17);
 
         // ---- this is the generic plot file type name
@@ -992,48 +1070,48 @@ ERF::WriteGenericPlotfileHeaderWithTerrain (std::ostream &HeaderFile,
         }
         HeaderFile << AMREX_SPACEDIM << '\n';
         HeaderFile << time << '\n';
-        HeaderFile << finest_level << '\n';
+        HeaderFile << flev << '\n';
         for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-            HeaderFile << geom[0].ProbLo(i) << ' ';
+            HeaderFile << level_geom[0].ProbLo(i) << ' ';
         }
         HeaderFile << '\n';
         for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-            HeaderFile << geom[0].ProbHi(i) << ' ';
+            HeaderFile << level_geom[0].ProbHi(i) << ' ';
         }
         HeaderFile << '\n';
-        for (int i = 0; i < finest_level; ++i) {
-            HeaderFile << ref_ratio[i][0] << ' ';
+        for (int i = 0; i < flev; ++i) {
+            HeaderFile << level_ref_ratio[i][0] << ' ';
         }
         HeaderFile << '\n';
-        for (int i = 0; i <= finest_level; ++i) {
-            HeaderFile << geom[i].Domain() << ' ';
+        for (int i = 0; i <= flev; ++i) {
+            HeaderFile << level_geom[i].Domain() << ' ';
         }
         HeaderFile << '\n';
-        for (int i = 0; i <= finest_level; ++i) {
+        for (int i = 0; i <= flev; ++i) {
             HeaderFile << level_steps[i] << ' ';
         }
         HeaderFile << '\n';
-        for (int i = 0; i <= finest_level; ++i) {
+        for (int i = 0; i <= flev; ++i) {
             for (int k = 0; k < AMREX_SPACEDIM; ++k) {
-                HeaderFile << geom[i].CellSize()[k] << ' ';
+                HeaderFile << level_geom[i].CellSize()[k] << ' ';
             }
             HeaderFile << '\n';
         }
-        HeaderFile << (int) geom[0].Coord() << '\n';
+        HeaderFile << (int) level_geom[0].Coord() << '\n';
         HeaderFile << "0\n";
 
-        for (int level = 0; level <= finest_level; ++level) {
+        for (int level = 0; level <= flev; ++level) {
             HeaderFile << level << ' ' << bArray[level].size() << ' ' << time << '\n';
             HeaderFile << level_steps[level] << '\n';
 
-            const IntVect& domain_lo = geom[level].Domain().smallEnd();
+            const IntVect& domain_lo = level_geom[level].Domain().smallEnd();
             for (int i = 0; i < bArray[level].size(); ++i)
             {
                 // Need to shift because the RealBox ctor we call takes the
                 // physical location of index (0,0,0).  This does not affect
                 // the usual cases where the domain index starts with 0.
                 const Box& b = shift(bArray[level][i], -domain_lo);
-                RealBox loc = RealBox(b, geom[level].CellSize(), geom[level].ProbLo());
+                RealBox loc = RealBox(b, level_geom[level].CellSize(), level_geom[level].ProbLo());
                 for (int n = 0; n < AMREX_SPACEDIM; ++n) {
                     HeaderFile << loc.lo(n) << ' ' << loc.hi(n) << '\n';
                 }
@@ -1047,7 +1125,7 @@ ERF::WriteGenericPlotfileHeaderWithTerrain (std::ostream &HeaderFile,
         HeaderFile << "amrexvec_nu_y" << "\n";
         HeaderFile << "amrexvec_nu_z" << "\n";
         std::string mf_nodal_prefix = "Nu_nd";
-        for (int level = 0; level <= finest_level; ++level) {
+        for (int level = 0; level <= flev; ++level) {
             HeaderFile << MultiFabHeaderPath(level, levelPrefix, mf_nodal_prefix) << '\n';
         }
 }
@@ -3,6 +3,7 @@
 #include "IndexDefines.H"
 #include "EOS.H"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <ctime>
@@ -50,24 +51,149 @@ std::time_t getEpochTime(const std::string& dateTime, const std::string& dateTim
     return epoch;
 }
 
-Real
-read_from_wrfbdy(std::string nc_bdy_file, const Box& domain,
-                 Vector<Vector<FArrayBox>>& bdy_data_xlo,
-                 Vector<Vector<FArrayBox>>& bdy_data_xhi,
-                 Vector<Vector<FArrayBox>>& bdy_data_ylo,
-                 Vector<Vector<FArrayBox>>& bdy_data_yhi,
-                 int& width)
-{
-    amrex::Print() << "Loading boundary data from NetCDF file " << std::endl;
+namespace {
 
-    int ioproc = ParallelDescriptor::IOProcessorNumber();  // I/O rank
+// The wrfbdy variables, in the order of WRFBdyVars, and the faces, in the order of WRFBdyTypes
+const Vector<std::string> nc_var_prefix  = {"U","V","R","T","QVAPOR","MU","PC"};
+const Vector<std::string> nc_face_suffix = {"_BXS","_BXE","_BYS","_BYE"};
 
+// The box of variable bdyVarType on face bdyType
+Box
+wrfbdy_box (const Box& domain, int width, int bdyType, int bdyVarType)
+{
     const auto& lo = domain.loVect();
     const auto& hi = domain.hiVect();
 
-    // *******************************************************************************
+    amrex::IntVect plo(lo);
+    amrex::IntVect phi(hi);
+
+    Box plane_no_stag, plane_x_stag, plane_y_stag, line;
+
+    if (bdyType == WRFBdyTypes::x_lo) {
+        plo[0] = lo[0]        ; plo[1] = lo[1]; plo[2] = lo[2];
+        phi[0] = lo[0]+width-1; phi[1] = hi[1]; phi[2] = hi[2];
+        const Box pbx_xlo(plo, phi);
+        plane_no_stag = pbx_xlo;
+        plane_x_stag  = pbx_xlo; plane_x_stag.shiftHalf(0,-1);
+        plane_y_stag  = convert(pbx_xlo, {0, 1, 0});
+        line = Box(IntVect(lo[0], lo[1], 0), IntVect(lo[0]+width-1, hi[1], 0));
+    } else if (bdyType == WRFBdyTypes::x_hi) {
+        plo[0] = hi[0]-width+1; plo[1] = lo[1]; plo[2] = lo[2];
+        phi[0] = hi[0]        ; phi[1] = hi[1]; phi[2] = hi[2];
+        const Box pbx_xhi(plo, phi);
+        plane_no_stag = pbx_xhi;
+        plane_x_stag  = pbx_xhi; plane_x_stag.shiftHalf(0,1);
+        plane_y_stag  = convert(pbx_xhi, {0, 1, 0});
+        line = Box(IntVect(hi[0]-width+1, lo[1], 0), IntVect(hi[0], hi[1], 0));
+    } else if (bdyType == WRFBdyTypes::y_lo) {
+        plo[1] = lo[1]        ; plo[0] = lo[0]; plo[2] = lo[2];
+        phi[1] = lo[1]+width-1; phi[0] = hi[0]; phi[2] = hi[2];
+        const Box pbx_ylo(plo, phi);
+        plane_no_stag = pbx_ylo;
+        plane_x_stag  = convert(pbx_ylo, {1, 0, 0});
+        plane_y_stag  = pbx_ylo; plane_y_stag.shiftHalf(1,-1);
+        line = Box(IntVect(lo[0], lo[1], 0), IntVect(hi[0], lo[1]+width-1, 0));
+    } else {
+        plo[1] = hi[1]-width+1; plo[0] = lo[0]; plo[2] = lo[2];
+        phi[1] = hi[1]        ; phi[0] = hi[0]; phi[2] = hi[2];
+        const Box pbx_yhi(plo, phi);
+        plane_no_stag = pbx_yhi;
+        plane_x_stag  = convert(pbx_yhi, {1, 0, 0});
+        plane_y_stag  = pbx_yhi; plane_y_stag.shiftHalf(1,1);
+        line = Box(IntVect(lo[0], hi[1]-width+1, 0), IntVect(hi[0], hi[1], 0));
+    }
+
+    if (bdyVarType == WRFBdyVars::U) {
+        return plane_x_stag;
+    } else if (bdyVarType == WRFBdyVars::V) {
+        return plane_y_stag;
+    } else if (bdyVarType == WRFBdyVars::MU || bdyVarType == WRFBdyVars::PC) {
+        return line;
+    } else {
+        return plane_no_stag; // R, T, QV
+    }
+}
+
+// The part of the box of variable bdyVarType on face bdyType along the stretch of the face
+//    covered by region; MU and PC reach one cell further each way since U and V are
+//    converted with the average of MU on either side of them
+Box
+wrfbdy_sub_box (const Box& domain, int width, int bdyType, int bdyVarType, const Box& region)
+{
+    Box bx = wrfbdy_box(domain, width, bdyType, bdyVarType);
+
+    // The direction along the face
+    const int dir = (bdyType == WRFBdyTypes::x_lo || bdyType == WRFBdyTypes::x_hi) ? 1 : 0;
+
+    int lo = region.smallEnd(dir);
+    int hi = region.bigEnd(dir);
+    if (bdyVarType == WRFBdyVars::MU || bdyVarType == WRFBdyVars::PC) {
+        lo -= 1;
+        hi += 1;
+    } else if (bx.ixType().nodeCentered(dir)) {
+        hi += 1;
+    }
+    bx.setSmall(dir, std::max(bx.smallEnd(dir), lo));
+    bx.setBig  (dir, std::min(bx.bigEnd(dir)  , hi));
+    return bx;
+}
+
+// Fill fab with the data read for variable bdyVarType on face bdyType, whose shape
+//    (without the time dimension) is (width, ns2, ns3) for 3D and (width, ns2) for 2D data
+void
+fill_wrfbdy_fab (FArrayBox& fab, int bdyType, int bdyVarType,
+                 const std::vector<size_t>& shape, const std::vector<float>& data)
+{
+    const bool is_3d = (bdyVarType != WRFBdyVars::MU && bdyVarType != WRFBdyVars::PC);
+
+    const int ns2 = static_cast<int>(shape[1]);
+    const int ns3 = is_3d ? static_cast<int>(shape[2]) : 1;
+
+    const long num_pts = fab.box().numPts();
+    AMREX_ALWAYS_ASSERT(num_pts <= static_cast<long>(data.size()));
+
+    // The data are stored from the edge of the domain inwards
+    int off, sgn;
+    if        (bdyType == WRFBdyTypes::x_lo) {
+        off = fab.smallEnd()[0]; sgn =  1;
+    } else if (bdyType == WRFBdyTypes::x_hi) {
+        off = fab.bigEnd()[0];   sgn = -1;
+    } else if (bdyType == WRFBdyTypes::y_lo) {
+        off = fab.smallEnd()[1]; sgn =  1;
+    } else {
+        off = fab.bigEnd()[1];   sgn = -1;
+    }
+    const bool x_face = (bdyType == WRFBdyTypes::x_lo || bdyType == WRFBdyTypes::x_hi);
+
+    Array4<Real> fab_arr = fab.array();
+    for (long n(0); n < num_pts; ++n) {
+        int w, k, t;
+        if (is_3d) {
+            w = static_cast<int>(n / (ns2 * ns3));
+            k = static_cast<int>((n - w * (ns2 * ns3)) / ns3);
+            t = static_cast<int>( n - w * (ns2 * ns3) - k * ns3);
+        } else {
+            w = static_cast<int>(n / ns2);
+            k = 0;
+            t = static_cast<int>(n - w * ns2);
+        }
+        if (x_face) {
+            fab_arr(off+sgn*w, t, k, 0) = static_cast<Real>(data[n]);
+        } else {
+            fab_arr(t, off+sgn*w, k, 0) = static_cast<Real>(data[n]);
+        }
+    }
+}
+
+} // namespace
+
+Real
+read_times_from_wrfbdy (const std::string& nc_bdy_file, int& ntimes, int& width)
+{
+    amrex::Print() << "Loading boundary data from NetCDF file " << nc_bdy_file << std::endl;
+
+    int ioproc = ParallelDescriptor::IOProcessorNumber();  // I/O rank
 
-    int ntimes;
     Real timeInterval;
     const std::string dateTimeFormat ="%Y-%m-%d_%H:%M:%S";
 
@@ -101,451 +227,229 @@ read_from_wrfbdy(std::string nc_bdy_file, const Box& domain,
             else if (nt >= 1)
                 AMREX_ALWAYS_ASSERT(epochTimes[nt] - epochTimes[nt-1] == timeInterval);
         }
+
+        // Width of the boundary region
+        auto ncf = ncutils::NCFile::open(nc_bdy_file, NC_NOWRITE);
+        std::vector<size_t> shape = ncf.var(nc_var_prefix[0] + nc_face_suffix[0]).shape();
+        ncf.close();
+
+        // Assert that the data has the same number of time snapshots
+        AMREX_ALWAYS_ASSERT(static_cast<int>(shape[0]) == ntimes);
+
+        width = static_cast<int>(shape[1]);
+        AMREX_ALWAYS_ASSERT(1 <= width && width <= 5);
     }
 
+    // Make sure all processors know the timeInterval, how many times are stored and the width
     ParallelDescriptor::Bcast(&ntimes,1,ioproc);
     ParallelDescriptor::Bcast(&timeInterval,1,ioproc);
+    ParallelDescriptor::Bcast(&width,1,ioproc);
 
-    // Even though we may not read in all the variables, we need to make the arrays big enough for them (for now)
-    int nvars = WRFBdyVars::NumTypes*4;
+    // Return the number of seconds between the boundary plane data
+    return timeInterval;
+}
 
-    // Our outermost loop is time
-    bdy_data_xlo.resize(ntimes);
-    bdy_data_xhi.resize(ntimes);
-    bdy_data_ylo.resize(ntimes);
-    bdy_data_yhi.resize(ntimes);
+WRFBdySlice
+read_slice_from_wrfbdy (const std::string& nc_bdy_file, int nt)
+{
+    // NOTE: this may run on a thread of its own, so it must not profile, print or communicate
 
-    amrex::IntVect plo(lo);
-    amrex::IntVect phi(hi);
+    const int nvars = WRFBdyVars::NumTypes*4;
 
-    // ******************************************************************
-    // Read the netcdf file and fill these FABs
-    // NOTE: the order and number of these must match the WRFBdyVars enum!
-    // WRFBdyVars:  U, V, R, T, QV, MU, PC
-    // ******************************************************************
-    Vector<std::string> nc_var_names;
-    Vector<std::string> nc_var_prefix = {"U","V","R","T","QVAPOR","MU","PC"};
+    WRFBdySlice slice;
+    slice.nt = nt;
+    slice.shape.resize(nvars);
+    slice.data.resize(nvars);
 
-    for (int ip = 0; ip < nc_var_prefix.size(); ++ip)
+    auto ncf = ncutils::NCFile::open(nc_bdy_file, NC_NOWRITE);
+    for (int ivar = 0; ivar < WRFBdyVars::NumTypes; ++ivar)
     {
-       nc_var_names.push_back(nc_var_prefix[ip] + "_BXS");
-       nc_var_names.push_back(nc_var_prefix[ip] + "_BXE");
-       nc_var_names.push_back(nc_var_prefix[ip] + "_BYS");
-       nc_var_names.push_back(nc_var_prefix[ip] + "_BYE");
+        // R is computed from the other data in convert_wrfbdy_data
+        if (ivar == WRFBdyVars::R) continue;
+
+        for (int face = 0; face < 4; ++face)
+        {
+            const int iv = ivar*4 + face;
+            auto var = ncf.var(nc_var_prefix[ivar] + nc_face_suffix[face]);
+
+            std::vector<size_t> count = var.shape();
+            std::vector<size_t> start(count.size(), 0);
+            start[0] = nt;
+            count[0] = 1;
+
+            size_t npts = 1;
+            for (auto c : count) npts *= c;
+
+            slice.shape[iv].assign(count.begin()+1, count.end());
+            slice.data[iv].resize(npts);
+            var.get(slice.data[iv].data(), start, count);
+        }
     }
+    ncf.close();
 
-    using RARRAY = NDArray<float>;
-    amrex::Vector<RARRAY> arrays(nc_var_names.size());
+    return slice;
+}
 
-    if (ParallelDescriptor::IOProcessor())
-    {
-        ReadNetCDFFile(nc_bdy_file, nc_var_names, arrays);
+void
+WRFBdyFaceComms::define (const Box& domain, const BoxArray& ba, const DistributionMapping& dm,
+                         const IntVect& ngrow)
+{
+    if (m_defined && domain == m_domain && ba == m_ba && dm == m_dm && ngrow == m_ngrow) return;
 
-        // Assert that the data has the same number of time snapshots
-        int itimes = static_cast<int>(arrays[0].get_vshape()[0]);
-        AMREX_ALWAYS_ASSERT(itimes == ntimes);
+    BL_PROFILE("WRFBdyFaceComms::define()");
 
-        // Width of the boundary region
-        width = arrays[0].get_vshape()[1];
+    clear();
+    m_domain = domain;
+    m_ba     = ba;
+    m_dm     = dm;
+    m_ngrow  = ngrow;
 
-        AMREX_ALWAYS_ASSERT(1 <= width && width <= 5);
-    }
-    ParallelDescriptor::Bcast(&width,1,ioproc);
+    const int  myproc = ParallelDescriptor::MyProc();
+    const bool ioproc = ParallelDescriptor::IOProcessor();
 
-    // This loops over every variable on every face, so nvars should be 4 * number of "ivartype" below
-    for (int iv = 0; iv < nvars; iv++)
+    for (int face = 0; face < 4; ++face)
     {
-        amrex::Print() << "Building FAB for the NetCDF variable : " << nc_var_names[iv] << std::endl;
-
-        int bdyVarType;
-
-        std::string first1 = nc_var_names[iv].substr(0,1);
-        std::string first2 = nc_var_names[iv].substr(0,2);
-
-        if        (first1 == "U") {
-            bdyVarType = WRFBdyVars::U;
-        } else if (first1 == "V") {
-            bdyVarType = WRFBdyVars::V;
-        } else if (first1 == "R") {
-            bdyVarType = WRFBdyVars::R;
-        } else if (first1 == "T") {
-            bdyVarType = WRFBdyVars::T;
-        } else if (first2 == "QV") {
-            bdyVarType = WRFBdyVars::QV;
-        } else if (first2 == "MU") {
-            bdyVarType = WRFBdyVars::MU;
-        } else if (first2 == "PC") {
-            bdyVarType = WRFBdyVars::PC;
-        } else {
-            amrex::Print() << "Trying to read " << first1 << " or " << first2 << std::endl;
-            amrex::Abort("dont know this variable");
-        }
-
-        std::string  last3 = nc_var_names[iv].substr(nc_var_names[iv].size()-3, 3);
-        int bdyType;
-
-        if        (last3 == "BXS") {
-            bdyType = WRFBdyTypes::x_lo;
-        } else if (last3 == "BXE") {
-            bdyType = WRFBdyTypes::x_hi;
-        } else if (last3 == "BYS") {
-            bdyType = WRFBdyTypes::y_lo;
-        } else if (last3 == "BYE") {
-            bdyType = WRFBdyTypes::y_hi;
+        // The cells near this face that each rank fills: its boxes on the face, grown by
+        //    the ghost cells, and cut back to the domain
+        const int dir = face / 2;
+        Vector<Box> region(ParallelDescriptor::NProcs());
+        for (int i = 0; i < ba.size(); ++i) {
+            const bool on_face = (face%2 == 0) ? (ba[i].smallEnd(dir) == domain.smallEnd(dir))
+                                               : (ba[i].bigEnd(dir)   == domain.bigEnd(dir));
+            if (!on_face) continue;
+            Box gbx = amrex::grow(ba[i], ngrow) & domain;
+            Box& r = region[dm[i]];
+            if (r.ok()) {
+                r.minBox(gbx);
+            } else {
+                r = gbx;
+            }
         }
 
-        Box y_line_no_stag(IntVect(lo[0], 0, 0), IntVect(hi[0], 0, 0));
-
-        if (bdyType == WRFBdyTypes::x_lo) {
-
-                // *******************************************************************************
-                // xlo bdy
-                // *******************************************************************************
-                plo[0] = lo[0]        ; plo[1] = lo[1]; plo[2] = lo[2];
-                phi[0] = lo[0]+width-1; phi[1] = hi[1]; phi[2] = hi[2];
-                const Box pbx_xlo(plo, phi);
-
-                Box xlo_plane_no_stag(pbx_xlo);
-                Box xlo_plane_x_stag = pbx_xlo; xlo_plane_x_stag.shiftHalf(0,-1);
-                Box xlo_plane_y_stag = convert(pbx_xlo, {0, 1, 0});
-
-                Box xlo_line(IntVect(lo[0], lo[1], 0), IntVect(lo[0]+width-1, hi[1], 0));
-
-                if        (bdyVarType == WRFBdyVars::U) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_plane_x_stag, 1)); // U
-                    }
-                } else if (bdyVarType == WRFBdyVars::V) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_plane_y_stag , 1)); // V
-                    }
-                } else if (bdyVarType == WRFBdyVars::R) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_plane_no_stag, 1)); // R
-                    }
-                } else if (bdyVarType == WRFBdyVars::T) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_plane_no_stag, 1)); // T
-                    }
-                } else if (bdyVarType == WRFBdyVars::QV) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_plane_no_stag, 1)); // QV
-                    }
-                } else if (bdyVarType == WRFBdyVars::MU ||
-                           bdyVarType == WRFBdyVars::PC) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xlo[nt].push_back(FArrayBox(xlo_line, 1));
-                    }
+        // The IOProcessor holds the whole face, from which it sends each rank its part
+        m_region[face] = ioproc ? domain : region[myproc];
+        if (ioproc) {
+            for (int proc = 0; proc < region.size(); ++proc) {
+                if (proc != myproc && region[proc].ok()) {
+                    m_dest[face].emplace_back(proc, region[proc]);
                 }
+            }
+        }
+    }
+    m_defined = true;
+}
 
-            } else if (bdyType == WRFBdyTypes::x_hi) {
-
-                // *******************************************************************************
-                // xhi bdy
-                // *******************************************************************************
-                plo[0] = hi[0]-width+1; plo[1] = lo[1]; plo[2] = lo[2];
-                phi[0] = hi[0]        ; phi[1] = hi[1]; phi[2] = hi[2];
-                const Box pbx_xhi(plo, phi);
-
-                Box xhi_plane_no_stag(pbx_xhi);
-                Box xhi_plane_x_stag = pbx_xhi; xhi_plane_x_stag.shiftHalf(0,1);
-                Box xhi_plane_y_stag = convert(pbx_xhi, {0, 1, 0});
-
-                Box xhi_line(IntVect(hi[0]-width+1, lo[1], 0), IntVect(hi[0], hi[1], 0));
-
-                //amrex::Print() << "HI XBX NO STAG " << pbx_xhi << std::endl;
-                //amrex::Print() << "HI XBX  X STAG " << xhi_plane_x_stag << std::endl;
-                //amrex::Print() << "HI XBX  Y STAG " << xhi_plane_y_stag << std::endl;
-
-                if        (bdyVarType == WRFBdyVars::U) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_plane_x_stag, 1)); // U
-                    }
-                } else if (bdyVarType == WRFBdyVars::V) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_plane_y_stag , 1)); // V
-                    }
-                } else if (bdyVarType == WRFBdyVars::R) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_plane_no_stag, 1)); // R
-                    }
-                } else if (bdyVarType == WRFBdyVars::T) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_plane_no_stag, 1)); // T
-                    }
-                } else if (bdyVarType == WRFBdyVars::QV) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_plane_no_stag, 1)); // QV
-                    }
-                } else if (bdyVarType == WRFBdyVars::MU ||
-                           bdyVarType == WRFBdyVars::PC) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_xhi[nt].push_back(FArrayBox(xhi_line, 1)); // MU
-                    }
-                }
+void
+WRFBdyFaceComms::clear ()
+{
+    for (int face = 0; face < 4; ++face) {
+        m_region[face] = Box();
+        m_dest[face].clear();
+    }
+    m_defined = false;
+}
 
-            } else if (bdyType == WRFBdyTypes::y_lo) {
-
-                // *******************************************************************************
-                // ylo bdy
-                // *******************************************************************************
-                plo[1] = lo[1]        ; plo[0] = lo[0]; plo[2] = lo[2];
-                phi[1] = lo[1]+width-1; phi[0] = hi[0]; phi[2] = hi[2];
-                const Box pbx_ylo(plo, phi);
-
-                Box ylo_plane_no_stag(pbx_ylo);
-                Box ylo_plane_x_stag = convert(pbx_ylo, {1, 0, 0});
-                Box ylo_plane_y_stag = pbx_ylo; ylo_plane_y_stag.shiftHalf(1,-1);
-
-                Box ylo_line(IntVect(lo[0], lo[1], 0), IntVect(hi[0], lo[1]+width-1, 0));
-
-                if        (bdyVarType == WRFBdyVars::U) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_plane_x_stag , 1)); // U
-                    }
-                } else if (bdyVarType == WRFBdyVars::V) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_plane_y_stag, 1)); // V
-                    }
-                } else if (bdyVarType == WRFBdyVars::R) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_plane_no_stag, 1)); // R
-                    }
-                } else if (bdyVarType == WRFBdyVars::T) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_plane_no_stag, 1)); // T
-                    }
-                } else if (bdyVarType == WRFBdyVars::QV) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_plane_no_stag, 1)); // QV
-                    }
-                } else if (bdyVarType == WRFBdyVars::MU ||
-                           bdyVarType == WRFBdyVars::PC) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_ylo[nt].push_back(FArrayBox(ylo_line, 1)); // PC
-                    }
-                }
+void
+distribute_wrfbdy_slice (const WRFBdySlice& raw, const Box& domain, int width,
+                         const WRFBdyFaceComms& comms,
+                         Vector<FArrayBox>& bdy_data_xlo,
+                         Vector<FArrayBox>& bdy_data_xhi,
+                         Vector<FArrayBox>& bdy_data_ylo,
+                         Vector<FArrayBox>& bdy_data_yhi)
+{
+    BL_PROFILE("distribute_wrfbdy_slice()");
+
+    Vector<FArrayBox>* bdy_data[4] = {&bdy_data_xlo, &bdy_data_xhi, &bdy_data_ylo, &bdy_data_yhi};
+
+    const bool ioproc = ParallelDescriptor::IOProcessor();
+
+#ifdef AMREX_USE_MPI
+    // Every message goes from the IOProcessor to one rank, and each rank posts its receives in
+    //    the order the IOProcessor posts the sends, so a single tag serves them all
+    const int tag = ParallelDescriptor::SeqNum();
+    const int ioproc_num = ParallelDescriptor::IOProcessorNumber();
+    Vector<FArrayBox>   send_fabs;
+    Vector<MPI_Request> reqs;
+    if (ioproc) {
+        std::size_t nsend = 0;
+        for (int face = 0; face < 4; ++face) nsend += comms.dest(face).size();
+        send_fabs.reserve(nsend * (WRFBdyVars::NumTypes-1));
+    }
+#endif
 
-            } else if (bdyType == WRFBdyTypes::y_hi) {
-
-                // *******************************************************************************
-                // yhi bdy
-                // *******************************************************************************
-                plo[1] = hi[1]-width+1; plo[0] = lo[0]; plo[2] = lo[2];
-                phi[1] = hi[1]        ; phi[0] = hi[0]; phi[2] = hi[2];
-                const Box pbx_yhi(plo, phi);
-
-                Box yhi_plane_no_stag(pbx_yhi);
-                Box yhi_plane_x_stag = convert(pbx_yhi, {1, 0, 0});
-                Box yhi_plane_y_stag = pbx_yhi; yhi_plane_y_stag.shiftHalf(1,1);
-
-                Box yhi_line(IntVect(lo[0], hi[1]-width+1, 0), IntVect(hi[0], hi[1], 0));
-
-                //amrex::Print() << "HI YBX NO STAG " << pbx_yhi << std::endl;
-                //amrex::Print() << "HI YBX  X STAG " << yhi_plane_x_stag << std::endl;
-                //amrex::Print() << "HI YBX  Y STAG " << yhi_plane_y_stag << std::endl;
-
-                if        (bdyVarType == WRFBdyVars::U) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_plane_x_stag , 1)); // U
-                    }
-                } else if (bdyVarType == WRFBdyVars::V) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_plane_y_stag, 1)); // V
-                    }
-                } else if (bdyVarType == WRFBdyVars::R) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_plane_no_stag, 1)); // R
-                    }
-                } else if (bdyVarType == WRFBdyVars::T) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_plane_no_stag, 1)); // T
-                    }
-                } else if (bdyVarType == WRFBdyVars::QV) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_plane_no_stag, 1)); // QV
-                    }
-                } else if (bdyVarType == WRFBdyVars::MU ||
-                           bdyVarType == WRFBdyVars::PC) {
-                    for (int nt(0); nt < ntimes; ++nt) {
-                        bdy_data_yhi[nt].push_back(FArrayBox(yhi_line, 1)); // PC
-                    }
-                }
+    for (int face = 0; face < 4; ++face)
+    {
+        Vector<FArrayBox>& fabs = *bdy_data[face];
+        fabs.clear();
+        fabs.resize(WRFBdyVars::NumTypes);
+        if (comms.need(face)) {
+            for (int ivar = 0; ivar < WRFBdyVars::NumTypes; ++ivar) {
+                fabs[ivar].resize(wrfbdy_sub_box(domain, width, face, ivar, comms.region(face)), 1);
+            }
         }
 
-        long num_pts;
+        if (ioproc) {
+            for (int ivar = 0; ivar < WRFBdyVars::NumTypes; ++ivar) {
+                if (ivar == WRFBdyVars::R) continue;
+                const int iv = ivar*4 + face;
+                fill_wrfbdy_fab(fabs[ivar], face, ivar, raw.shape[iv], raw.data[iv]);
+            }
+        }
 
-        // Now fill the data
-        if (ParallelDescriptor::IOProcessor())
-        {
-            // amrex::Print() << "SHAPE0 " << arrays[iv].get_vshape()[0] << std::endl;
-            // amrex::Print() << "SHAPE1 " << arrays[iv].get_vshape()[1] << std::endl;
-            // amrex::Print() << "SHAPE2 " << arrays[iv].get_vshape()[2] << std::endl;
-            // amrex::Print() << "SHAPE3 " << arrays[iv].get_vshape()[3] << std::endl;
-
-            Array4<Real> fab_arr;
-            if (bdyVarType == WRFBdyVars::U || bdyVarType == WRFBdyVars::V ||
-                bdyVarType == WRFBdyVars::R || bdyVarType == WRFBdyVars::T ||
-                bdyVarType == WRFBdyVars::QV)
-            {
-                int ns2 = arrays[iv].get_vshape()[2];
-                int ns3 = arrays[iv].get_vshape()[3];
-
-                if (bdyType == WRFBdyTypes::x_lo) {
-                    num_pts  = bdy_data_xlo[0][bdyVarType].box().numPts();
-                    int ioff = bdy_data_xlo[0][bdyVarType].smallEnd()[0];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_xlo[nt][bdyVarType].array();
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int i = n / (ns2 * ns3);
-                            int k = (n - i * (ns2 * ns3)) / ns3;
-                            int j =  n - i * (ns2 * ns3) - k * ns3;
-                            fab_arr(ioff+i, j, k, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::x_hi) {
-                    num_pts  = bdy_data_xhi[0][bdyVarType].box().numPts();
-                    int ioff = bdy_data_xhi[0][bdyVarType].bigEnd()[0];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_xhi[nt][bdyVarType].array();
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int i = n / (ns2 * ns3);
-                            int k = (n - i * (ns2 * ns3)) / ns3;
-                            int j =  n - i * (ns2 * ns3) - k * ns3;
-                            fab_arr(ioff-i, j, k, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::y_lo) {
-                    num_pts  = bdy_data_ylo[0][bdyVarType].box().numPts();
-                    int joff = bdy_data_ylo[0][bdyVarType].smallEnd()[1];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_ylo[nt][bdyVarType].array();
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int j = n / (ns2 * ns3);
-                            int k = (n - j * (ns2 * ns3)) / ns3;
-                            int i =  n - j * (ns2 * ns3) - k * ns3;
-                            fab_arr(i, joff+j, k, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::y_hi) {
-                    num_pts  = bdy_data_yhi[0][bdyVarType].box().numPts();
-                    int joff = bdy_data_yhi[0][bdyVarType].bigEnd()[1];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_yhi[nt][bdyVarType].array();
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int j = n / (ns2 * ns3);
-                            int k = (n - j * (ns2 * ns3)) / ns3;
-                            int i =  n - j * (ns2 * ns3) - k * ns3;
-                            fab_arr(i, joff-j, k, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } // bdyType
-
-            } else if (bdyVarType == WRFBdyVars::MU || bdyVarType == WRFBdyVars::PC) {
-
-                if (bdyType == WRFBdyTypes::x_lo) {
-                    num_pts  = bdy_data_xlo[0][bdyVarType].box().numPts();
-                    int ioff = bdy_data_xlo[0][bdyVarType].smallEnd()[0];
-                    int ns2 = arrays[iv].get_vshape()[2];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_xlo[nt][bdyVarType].array();
-
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int i = n / ns2;
-                            int j = n - i * ns2;
-                            fab_arr(ioff+i, j, 0, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::x_hi) {
-                    num_pts  = bdy_data_xhi[0][bdyVarType].box().numPts();
-                    int ioff = bdy_data_xhi[0][bdyVarType].bigEnd()[0];
-                    int ns2 = arrays[iv].get_vshape()[2];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_xhi[nt][bdyVarType].array();
-
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int i = n / ns2;
-                            int j = n - i * ns2;
-                            fab_arr(ioff-i, j, 0, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::y_lo) {
-                    num_pts  = bdy_data_ylo[0][bdyVarType].box().numPts();
-                    int joff = bdy_data_ylo[0][bdyVarType].smallEnd()[1];
-                    int ns2 = arrays[iv].get_vshape()[2];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_ylo[nt][bdyVarType].array();
-
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int j = n / ns2;
-                            int i = n - j * ns2;
-                            fab_arr(i, joff+j, 0, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
-                } else if (bdyType == WRFBdyTypes::y_hi) {
-                    num_pts  = bdy_data_yhi[0][bdyVarType].box().numPts();
-                    int joff = bdy_data_yhi[0][bdyVarType].bigEnd()[1];
-                    int ns2 = arrays[iv].get_vshape()[2];
-                    for (int nt(0); nt < ntimes; ++nt)
-                    {
-                        fab_arr  = bdy_data_yhi[nt][bdyVarType].array();
-
-                        int n_off = nt * num_pts;
-                        for (int n(0); n < num_pts; ++n) {
-                            int j = n / ns2;
-                            int i = n - j * ns2;
-                            fab_arr(i, joff-j, 0, 0) = static_cast<Real>(*(arrays[iv].get_data() + n + n_off));
-                        }
-                    }
+#ifdef AMREX_USE_MPI
+        // Send each rank on this face only the part of the face it holds
+        if (ioproc) {
+            for (const auto& [proc, region] : comms.dest(face)) {
+                for (int ivar = 0; ivar < WRFBdyVars::NumTypes; ++ivar) {
+                    if (ivar == WRFBdyVars::R) continue;
+                    const Box sbx = wrfbdy_sub_box(domain, width, face, ivar, region);
+                    FArrayBox& sfab = send_fabs.emplace_back(sbx, 1);
+                    sfab.template copy<RunOn::Host>(fabs[ivar], sbx);
+                    reqs.push_back(ParallelDescriptor::Asend(sfab.dataPtr(), sbx.numPts(),
+                                                             proc, tag).req());
                 }
-            } // bdyVarType
-        } // if ParalleDescriptor::IOProcessor()
-    } // nc_var_names
-
-    // We put a barrier here so the rest of the processors wait to do anything until they have the data
-    amrex::ParallelDescriptor::Barrier();
-
-    // When an FArrayBox is built, space is allocated on every rank.  However, we only
-    //    filled the data in these FABs on the IOProcessor.  So here we broadcast
-    //    the data to every rank.
-    int n_per_time = nc_var_prefix.size();
-    for (int nt = 0; nt < ntimes; nt++)
-    {
-        for (int i = 0; i < n_per_time; i++)
-        {
-            ParallelDescriptor::Bcast(bdy_data_xlo[nt][i].dataPtr(),bdy_data_xlo[nt][i].box().numPts(),ioproc);
-            ParallelDescriptor::Bcast(bdy_data_xhi[nt][i].dataPtr(),bdy_data_xhi[nt][i].box().numPts(),ioproc);
-            ParallelDescriptor::Bcast(bdy_data_ylo[nt][i].dataPtr(),bdy_data_ylo[nt][i].box().numPts(),ioproc);
-            ParallelDescriptor::Bcast(bdy_data_yhi[nt][i].dataPtr(),bdy_data_yhi[nt][i].box().numPts(),ioproc);
+            }
+        } else if (comms.need(face)) {
+            for (int ivar = 0; ivar < WRFBdyVars::NumTypes; ++ivar) {
+                if (ivar == WRFBdyVars::R) continue;
+                reqs.push_back(ParallelDescriptor::Arecv(fabs[ivar].dataPtr(), fabs[ivar].box().numPts(),
+                                                         ioproc_num, tag).req());
+            }
         }
+#endif
     }
 
-    // Make sure all processors know how timeInterval
-    ParallelDescriptor::Bcast(&timeInterval,1,ioproc);
+#ifdef AMREX_USE_MPI
+    Vector<MPI_Status> stats(reqs.size());
+    ParallelDescriptor::Waitall(reqs, stats);
+#endif
+}
 
-    // Make sure all processors know how many times are stored
-    ParallelDescriptor::Bcast(&ntimes,1,ioproc);
+FArrayBox
+wrfbdy_face_strip (const FArrayBox& src, int face, const Box& domain, int width)
+{
+    const int dir = face / 2;
+
+    // Vertical profiles (C1H, C2H, RDNW) are needed whole; otherwise we keep the cells
+    //    (or faces) within width of the face, and one more on either side
+    Box bx = src.box();
+    if (bx.length(dir) > 1) {
+        if (face%2 == 0) {
+            bx.setSmall(dir, std::max(bx.smallEnd(dir), domain.smallEnd(dir)-1));
+            bx.setBig  (dir, std::min(bx.bigEnd(dir)  , domain.smallEnd(dir)+width));
+        } else {
+            bx.setSmall(dir, std::max(bx.smallEnd(dir), domain.bigEnd(dir)-width));
+            bx.setBig  (dir, std::min(bx.bigEnd(dir)  , domain.bigEnd(dir)+1));
+        }
+    }
 
-    // Return the number of seconds between the boundary plane data
-    return timeInterval;
+    FArrayBox strip(bx, src.nComp());
+    strip.template copy<RunOn::Device>(src, bx);
+    return strip;
 }
 
 void
-convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy_data,
+convert_wrfbdy_data(int which, const Box& domain, Vector<FArrayBox>& bdy_data, bool report_diff,
                     const FArrayBox& NC_MUB_fab,
                     const FArrayBox& NC_MSFU_fab, const FArrayBox& NC_MSFV_fab,
                     const FArrayBox& NC_MSFM_fab,
@@ -571,22 +475,23 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
     Array4<Real const> r_arr   = NC_rho_fab.const_array();
     Array4<Real const> rth_arr = NC_rhotheta_fab.const_array();
 
-    int ntimes = bdy_data.size();
-    for (int nt = 0; nt < ntimes; nt++)
+    // Nothing to do on a rank that does not hold the data of this face
+    if (!bdy_data[WRFBdyVars::U].box().ok()) return;
+
     {
-        Array4<Real> bdy_u_arr  = bdy_data[nt][WRFBdyVars::U].array();  // This is face-centered
-        Array4<Real> bdy_v_arr  = bdy_data[nt][WRFBdyVars::V].array();
-        Array4<Real> bdy_r_arr  = bdy_data[nt][WRFBdyVars::R].array();
-        Array4<Real> bdy_t_arr  = bdy_data[nt][WRFBdyVars::T].array();
-        Array4<Real> bdy_qv_arr = bdy_data[nt][WRFBdyVars::QV].array();
-        Array4<Real> mu_arr     = bdy_data[nt][WRFBdyVars::MU].array(); // This is cell-centered
+        Array4<Real> bdy_u_arr  = bdy_data[WRFBdyVars::U].array();  // This is face-centered
+        Array4<Real> bdy_v_arr  = bdy_data[WRFBdyVars::V].array();
+        Array4<Real> bdy_r_arr  = bdy_data[WRFBdyVars::R].array();
+        Array4<Real> bdy_t_arr  = bdy_data[WRFBdyVars::T].array();
+        Array4<Real> bdy_qv_arr = bdy_data[WRFBdyVars::QV].array();
+        Array4<Real> mu_arr     = bdy_data[WRFBdyVars::MU].array(); // This is cell-centered
 
         int ilo  = domain.smallEnd()[0];
         int ihi  = domain.bigEnd()[0];
         int jlo  = domain.smallEnd()[1];
         int jhi  = domain.bigEnd()[1];
 
-        auto& bx_u  = bdy_data[0][WRFBdyVars::U].box();
+        auto& bx_u  = bdy_data[WRFBdyVars::U].box();
         amrex::ParallelFor(bx_u, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
             Real xmu;
             if (i == ilo) {
@@ -603,9 +508,9 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
         });
 
 #ifndef AMREX_USE_GPU
-        if (nt == 0) {
+        if (report_diff) {
             FArrayBox diff(bx_u,1);
-            diff.template copy<RunOn::Device>(bdy_data[0][WRFBdyVars::U]);
+            diff.template copy<RunOn::Device>(bdy_data[WRFBdyVars::U]);
             diff.template minus<RunOn::Device>(NC_xvel_fab);
             if (which == 0)
                 amrex::Print() << "Max norm of diff between initial U and bdy U on lo x face: " << diff.norm(0) << std::endl;
@@ -618,7 +523,7 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
         }
 #endif
 
-        auto& bx_v  = bdy_data[0][WRFBdyVars::V].box();
+        auto& bx_v  = bdy_data[WRFBdyVars::V].box();
         amrex::ParallelFor(bx_v, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
             Real xmu;
             if (j == jlo) {
@@ -635,9 +540,9 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
         });
 
 #ifndef AMREX_USE_GPU
-        if (nt == 0) {
+        if (report_diff) {
             FArrayBox diff(bx_v,1);
-            diff.template copy<RunOn::Device>(bdy_data[0][WRFBdyVars::V]);
+            diff.template copy<RunOn::Device>(bdy_data[WRFBdyVars::V]);
             diff.template minus<RunOn::Device>(NC_yvel_fab);
             if (which == 0)
                 amrex::Print() << "Max norm of diff between initial V and bdy V on lo x face: " << diff.norm(0) << std::endl;
@@ -650,7 +555,7 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
         }
 #endif
 
-        auto& bx_t = bdy_data[0][WRFBdyVars::T].box(); // Note this is currently "THM" aka the perturbational moist pot. temp.
+        auto& bx_t = bdy_data[WRFBdyVars::T].box(); // Note this is currently "THM" aka the perturbational moist pot. temp.
 
         // Define density
         amrex::ParallelFor(bx_t, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
@@ -689,9 +594,9 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
         });
 
 #ifndef AMREX_USE_GPU
-        if (nt == 0) {
+        if (report_diff) {
             FArrayBox diff(bx_t,1);
-            diff.template copy<RunOn::Device>(bdy_data[0][WRFBdyVars::R]);
+            diff.template copy<RunOn::Device>(bdy_data[WRFBdyVars::R]);
             //diff.template mult<RunOn::Device>(NC_rho_fab);
             diff.template minus<RunOn::Device>(NC_rho_fab);
             if (which == 0)
@@ -703,7 +608,7 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
             if (which == 3)
                 amrex::Print() << "Max norm of diff between initial r and bdy r on hi y face: " << diff.norm(0) << std::endl;
 
-            diff.template copy<RunOn::Device>(bdy_data[0][WRFBdyVars::T]);
+            diff.template copy<RunOn::Device>(bdy_data[WRFBdyVars::T]);
             diff.template minus<RunOn::Device>(NC_rhotheta_fab);
             if (which == 0)
                 amrex::Print() << "Max norm of diff between initial rTh and bdy rTh on lo x face: " << diff.norm(0) << std::endl;
@@ -715,6 +620,6 @@ convert_wrfbdy_data(int which, const Box& domain, Vector<Vector<FArrayBox>>& bdy
                 amrex::Print() << "Max norm of diff between initial rTh and bdy rTh on hi y face: " << diff.norm(0) << std::endl;
         }
 #endif
-    } // ntimes
+    }
 }
 #endif // ERF_USE_NETCDF
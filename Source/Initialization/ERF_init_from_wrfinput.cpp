@@ -25,31 +25,6 @@ read_from_wrfinput(int lev, const std::string& fname,
                    FArrayBox& NC_PH_fab  , FArrayBox& NC_PHB_fab,
                    FArrayBox& NC_ALB_fab , FArrayBox& NC_PB_fab);
 
-Real
-read_from_wrfbdy(std::string nc_bdy_file, const Box& domain,
-                 Vector<Vector<FArrayBox>>& bdy_data_xlo,
-                 Vector<Vector<FArrayBox>>& bdy_data_xhi,
-                 Vector<Vector<FArrayBox>>& bdy_data_ylo,
-                 Vector<Vector<FArrayBox>>& bdy_data_yhi,
-                 int& width);
-
-void
-convert_wrfbdy_data(int which, const Box& domain,
-                    Vector<Vector<FArrayBox>>& bdy_data,
-                    const FArrayBox& NC_MUB_fab,
-                    const FArrayBox& NC_MSFU_fab,
-                    const FArrayBox& NC_MSFV_fab,
-                    const FArrayBox& NC_MSFM_fab,
-                    const FArrayBox& NC_PH_fab,
-                    const FArrayBox& NC_PHB_fab,
-                    const FArrayBox& NC_C1H_fab,
-                    const FArrayBox& NC_C2H_fab,
-                    const FArrayBox& NC_RDNW_fab,
-                    const FArrayBox& NC_xvel_fab,
-                    const FArrayBox& NC_yvel_fab,
-                    const FArrayBox& NC_rho_fab,
-                    const FArrayBox& NC_rhoth_fab);
-
 void
 init_state_from_wrfinput(int lev, FArrayBox& state_fab,
                          FArrayBox& x_vel_fab, FArrayBox& y_vel_fab,
@@ -190,33 +165,30 @@ ERF::init_from_wrfinput(int lev)
     if (init_type == "real" && (lev == 0)) {
         if (nc_bdy_file.empty())
             amrex::Error("NetCDF boundary file name must be provided via input");
-        bdy_time_interval = read_from_wrfbdy(nc_bdy_file,geom[0].Domain(),
-                                             bdy_data_xlo,bdy_data_xhi,bdy_data_ylo,bdy_data_yhi,
-                                             wrfbdy_width);
-        amrex::Print() << "Read in boundary data with width " << wrfbdy_width << std::endl;
+        bdy_time_interval = read_times_from_wrfbdy(nc_bdy_file,wrfbdy_ntimes,wrfbdy_width);
+        amrex::Print() << "Found " << wrfbdy_ntimes << " times of boundary data with width " << wrfbdy_width << std::endl;
 
         const Box& domain = geom[lev].Domain();
 
-        convert_wrfbdy_data(0,domain,bdy_data_xlo,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(1,domain,bdy_data_xhi,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(2,domain,bdy_data_ylo,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(3,domain,bdy_data_yhi,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+        // Keep the parts of the initial data near each face that we need to convert the boundary data
+        wrfbdy_conv_fabs.resize(4);
+        for (int face = 0; face < 4; ++face) {
+            wrfbdy_conv_fabs[face].clear();
+            for (const FArrayBox* fab : {&NC_MUB_fab[0], &NC_MSFU_fab[0], &NC_MSFV_fab[0], &NC_MSFM_fab[0],
+                                         &NC_PH_fab[0] , &NC_PHB_fab[0],
+                                         &NC_C1H_fab[0], &NC_C2H_fab[0], &NC_RDNW_fab[0],
+                                         &NC_xvel_fab[0],&NC_yvel_fab[0],&NC_rho_fab[0],&NC_rhoth_fab[0]}) {
+                wrfbdy_conv_fabs[face].push_back(wrfbdy_face_strip(*fab,face,domain,wrfbdy_width));
+            }
+        }
+
+        // The time slices are read as they are needed
+        bdy_data_xlo.clear(); bdy_data_xlo.resize(wrfbdy_ntimes);
+        bdy_data_xhi.clear(); bdy_data_xhi.resize(wrfbdy_ntimes);
+        bdy_data_ylo.clear(); bdy_data_ylo.resize(wrfbdy_ntimes);
+        bdy_data_yhi.clear(); bdy_data_yhi.resize(wrfbdy_ntimes);
+
+        update_wrfbdy_window(t_new[0], 0.0);
     }
 }
 
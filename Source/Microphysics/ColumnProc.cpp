@@ -0,0 +1,146 @@
+/*
+ * Cloud, Diagnose, IceFall and Precip applied in a single pass over each column
+ */
+#include "Microphysics.H"
+#include "Microphysics_Kernels.H"
+#include "IndexDefines.H"
+#include "TileNoZ.H"
+
+using namespace amrex;
+
+namespace {
+
+// Flux of cloud ice through the bottom face of cell k, as in IceFall
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real
+ice_fall_flux (int i, int j, int k, int nz, Real coef,
+               const Array4<const Real>& qci, const Table1D<Real>& rho1d)
+{
+    int kc = std::min(k+1, nz-1);
+    int kb = std::max(k-1, 0);
+    return mic_ice_fall_flux(rho1d(kc)*qci(i,j,kc), rho1d(k)*qci(i,j,k), rho1d(kb)*qci(i,j,kb), coef);
+}
+
+} // namespace
+
+/**
+ * Does the work of Cloud(), Diagnose(), IceFall(), Precip() and the first half of
+ * MicroPrecipFall() -- in that order -- but visits each column only once, so qt, qp, qn
+ * and tabs stay in cache between the steps instead of going through memory once per step.
+ *
+ * Within a column the saturation adjustment and the diagnostic partitioning are done first,
+ * since the ice fall at level k needs the cloud ice at k-1, k and k+1, and then the ice fall
+ * and precipitation are done bottom to top, carrying the ice flux from one face to the next.
+ *
+ * The sedimentation of precipitation is still done separately by PrecipFall.
+ *
+ * Unlike IceFall we do not restrict the ice fall to the levels that contain ice anywhere in
+ * the domain; the flux through a face is zero unless the cell above it contains ice, so the
+ * result is the same and we avoid a global reduction between the steps.
+ */
+void Microphysics::ColumnProc() {
+
+  BL_PROFILE("Microphysics::ColumnProc()");
+
+  auto accrrc_t  = accrrc.table();
+  auto accrsc_t  = accrsc.table();
+  auto accrsi_t  = accrsi.table();
+  auto accrgc_t  = accrgc.table();
+  auto accrgi_t  = accrgi.table();
+  auto coefice_t = coefice.table();
+  auto evapr1_t  = evapr1.table();
+  auto evapr2_t  = evapr2.table();
+  auto evaps1_t  = evaps1.table();
+  auto evaps2_t  = evaps2.table();
+  auto evapg1_t  = evapg1.table();
+  auto evapg2_t  = evapg2.table();
+  auto qpsrc_t   = qpsrc.table();
+  auto qpevp_t   = qpevp.table();
+  auto qifall_t  = qifall.table();
+  auto tlatqi_t  = tlatqi.table();
+  auto pres1d_t  = pres1d.table();
+  auto rho1d_t   = rho1d.table();
+
+  Real fac_cond = m_fac_cond;
+  Real fac_sub  = m_fac_sub;
+  Real fac_fus  = m_fac_fus;
+
+  const SaturationLookup sat = m_sat_table.view();
+
+  Real dtn  = dt;
+  Real coef = dtn/m_geom.CellSize(2);
+  int  nz   = nlev;
+
+  ParallelFor(nz, [=] AMREX_GPU_DEVICE (int k) noexcept {
+    qpsrc_t(k)  = 0.0;
+    qpevp_t(k)  = 0.0;
+    qifall_t(k) = 0.0;
+    tlatqi_t(k) = 0.0;
+  });
+
+  for ( MFIter mfi(*mic_fab_vars[MicVar::tabs], TileNoZ()); mfi.isValid(); ++mfi) {
+     auto qt_array    = mic_fab_vars[MicVar::qt]->array(mfi);
+     auto qp_array    = mic_fab_vars[MicVar::qp]->array(mfi);
+     auto qn_array    = mic_fab_vars[MicVar::qn]->array(mfi);
+     auto tabs_array  = mic_fab_vars[MicVar::tabs]->array(mfi);
+     auto theta_array = mic_fab_vars[MicVar::theta]->array(mfi);
+     auto qv_array    = mic_fab_vars[MicVar::qv]->array(mfi);
+     auto qcl_array   = mic_fab_vars[MicVar::qcl]->array(mfi);
+     auto qci_array   = mic_fab_vars[MicVar::qci]->array(mfi);
+     auto qpl_array   = mic_fab_vars[MicVar::qpl]->array(mfi);
+     auto qpi_array   = mic_fab_vars[MicVar::qpi]->array(mfi);
+     auto omega_array = mic_fab_vars[MicVar::omega]->array(mfi);
+
+     const auto& box3d = mfi.tilebox();
+
+     // Cloud() is only applied on the grids we evolve
+     const Box cloud_box = box3d & m_gtoe[mfi.index()];
+
+     const int klo = box3d.smallEnd(2);
+     const int khi = box3d.bigEnd(2);
+
+     Box box2d(box3d);
+     box2d.setRange(2,0);
+
+     ParallelFor(box2d, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+     {
+        // Saturation adjustment, the diagnostic partitioning and the precipitation fraction
+        for (int k = klo; k <= khi; ++k) {
+            if (cloud_box.contains(IntVect(i,j,k))) {
+                mic_cloud_adjust(qt_array(i,j,k), qp_array(i,j,k), qn_array(i,j,k), tabs_array(i,j,k),
+                                 pres1d_t(k), fac_cond, fac_sub, fac_fus, sat);
+            }
+            mic_diagnose(qt_array(i,j,k), qp_array(i,j,k), qn_array(i,j,k), tabs_array(i,j,k),
+                         qv_array(i,j,k), qcl_array(i,j,k), qci_array(i,j,k), qpl_array(i,j,k), qpi_array(i,j,k));
+            omega_array(i,j,k) = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tprmin)*a_pr));
+        }
+
+        // Ice fall followed by autoconversion, accretion and evaporation
+        Real fz_lo = ice_fall_flux(i, j, klo, nz, coef, qci_array, rho1d_t);
+        for (int k = klo; k <= khi; ++k) {
+            Real fz_hi = (k < khi) ? ice_fall_flux(i, j, k+1, nz, coef, qci_array, rho1d_t) : 0.0;
+
+            // The cloud ice increment is the difference of the fluxes; the latent heat
+            //    flux it induces uses the latent heat of sublimation
+            Real dqi      = coef*(fz_lo - fz_hi);
+            Real lat_heat = (fac_cond+fac_fus)*dqi;
+            qt_array(i,j,k)    += dqi;
+            theta_array(i,j,k) -= lat_heat;
+            if (dqi != 0.0) {
+                amrex::Gpu::Atomic::Add(&qifall_t(k),  dqi);
+                amrex::Gpu::Atomic::Add(&tlatqi_t(k), -lat_heat);
+            }
+            fz_lo = fz_hi;
+
+            const PrecipCoefs coefs{accrrc_t(k), accrsc_t(k), accrsi_t(k), accrgc_t(k), accrgi_t(k), coefice_t(k),
+                                    evapr1_t(k), evapr2_t(k), evaps1_t(k), evaps2_t(k), evapg1_t(k), evapg2_t(k)};
+            Real dqsrc = 0.0;
+            Real dqevp = 0.0;
+            mic_precip(qt_array(i,j,k), qp_array(i,j,k), qn_array(i,j,k), tabs_array(i,j,k),
+                       pres1d_t(k), coefs, dtn, sat, dqsrc, dqevp);
+            if (dqsrc != 0.0) amrex::Gpu::Atomic::Add(&qpsrc_t(k), dqsrc);
+            if (dqevp != 0.0) amrex::Gpu::Atomic::Add(&qpevp_t(k), dqevp);
+        }
+     });
+  }
+}
@@ -1,4 +1,5 @@
 #include "Microphysics.H"
+#include "Microphysics_Kernels.H"
 
 void Microphysics::Diagnose() {
 
@@ -26,13 +27,8 @@ void Microphysics::Diagnose() {
      const auto& box3d = mfi.tilebox();
 
      amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-       qv_array(i,j,k)  = qt_array(i,j,k) - qn_array(i,j,k);
-       amrex::Real omn  = std::max(0.0, std::min(1.0,(tabs_array(i,j,k)-tbgmin)*a_bg));
-       qcl_array(i,j,k) = qn_array(i,j,k)*omn;
-       qci_array(i,j,k) = qn_array(i,j,k)*(1.0-omn);
-       amrex::Real omp  = std::max(0.0, std::min(1.0,(tabs_array(i,j,k)-tprmin)*a_pr));
-       qpl_array(i,j,k) = qp_array(i,j,k)*omp;
-       qpi_array(i,j,k) = qp_array(i,j,k)*(1.0-omp);
+       mic_diagnose(qt_array(i,j,k), qp_array(i,j,k), qn_array(i,j,k), tabs_array(i,j,k),
+                    qv_array(i,j,k), qcl_array(i,j,k), qci_array(i,j,k), qpl_array(i,j,k), qpi_array(i,j,k));
      });
   }
 }
@@ -2,6 +2,7 @@
 #include <AMReX_ParReduce.H>
 #include "Microphysics.H"
 #include "TileNoZ.H"
+#include "Microphysics_Kernels.H"
 
 using namespace amrex;
 
@@ -91,26 +92,8 @@ void Microphysics::IceFall() {
          Real qic = rho1d_t(k )*qci_array(i,j,k );
          Real qid = rho1d_t(kb)*qci_array(i,j,kb);
 
-         // Ice sedimentation velocity depends on ice content. The fiting is
-         // based on the data by Heymsfield (JAS,2003). -Marat
-         Real vt_ice = min( 0.4 , 8.66 * pow( (max(0.,qic)+1.e-10) , 0.24) );   // Heymsfield (JAS, 2003, p.2607)
-
-         // Use MC flux limiter in computation of flux correction.
-         // (MC = monotonized centered difference).
-         //         if (qic.eq.qid) then
-         Real tmp_phi;
-         if ( std::abs(qic-qid) < 1.0e-25 ) {  // when qic, and qid is very small, qic_qid can still be zero
-           // even if qic is not equal to qid. so add a fix here +++mhwang
-           tmp_phi = 0.;
-         } else {
-           Real tmp_theta = (qiu-qic)/(qic-qid+1.0e-20);
-           tmp_phi = max(0., min(0.5*(1.+tmp_theta), min(2., 2.*tmp_theta)));
-         }
-
-         // Compute limited flux.
-         // Since falling cloud ice is a 1D advection problem, this
-         // flux-limited advection scheme is monotonic.
-         fz_array(i,j,k) = -vt_ice*(qic - 0.5*(1.-coef*vt_ice)*tmp_phi*(qic-qid));
+         // Compute the limited flux
+         fz_array(i,j,k) = mic_ice_fall_flux(qiu, qic, qid, coef);
        }
      });
 
@@ -15,21 +15,50 @@ void Microphysics::Init(const MultiFab& cons_in,
                         const BoxArray& grids_to_evolve,
                         const Geometry& geom,
                         const Real& dt_advance)
- {
+{
+  if (!IsDefinedFor(cons_in, grids_to_evolve, geom)) {
+      Define(cons_in, qv_in, grids_to_evolve, geom);
+  }
+  LoadState(cons_in, qc_in, qi_in, dt_advance);
+}
+
+bool Microphysics::IsDefinedFor(const MultiFab& cons_in,
+                                const BoxArray& grids_to_evolve,
+                                const Geometry& geom) const
+{
+  return m_defined &&
+         mic_fab_vars[0]->boxArray()        == cons_in.boxArray() &&
+         mic_fab_vars[0]->DistributionMap() == cons_in.DistributionMap() &&
+         mic_fab_vars[0]->nGrowVect()       == cons_in.nGrowVect() &&
+         m_gtoe                             == grids_to_evolve &&
+         m_geom.Domain()                    == geom.Domain() &&
+         m_geom.CellSize(2)                 == geom.CellSize(2) &&
+         m_geom.ProbLo(2)                   == geom.ProbLo(2);
+}
+
+void Microphysics::Define(const MultiFab& cons_in,
+                                MultiFab& qv_in,
+                          const BoxArray& grids_to_evolve,
+                          const Geometry& geom)
+{
+  BL_PROFILE("Microphysics::Define()");
+
   m_geom = geom;
   m_gtoe = grids_to_evolve;
 
   auto dz   = m_geom.CellSize(2);
   auto lowz = m_geom.ProbLo(2);
 
-  dt = dt_advance;
-
   // initialize microphysics variables
+  // (the ghost cells of these are never written so they stay zero)
   for (auto ivar = 0; ivar < MicVar::NumVars; ++ivar) {
      mic_fab_vars[ivar] = std::make_shared<MultiFab>(cons_in.boxArray(), cons_in.DistributionMap(), 1, cons_in.nGrowVect());
      mic_fab_vars[ivar]->setVal(0.);
   }
 
+  // only PrecipFall uses these, on the valid region
+  m_fall_vars.define(cons_in.boxArray(), cons_in.DistributionMap(), FallVar::NumVars, 0);
+
   // We must initialize to zero since we now need boundary values for the call to getP and we need all values filled
   // The ghost cells of these arrays aren't filled in the boundary condition calls for the state
   qv_in.setVal(0.);
@@ -74,6 +103,66 @@ void Microphysics::Init(const MultiFab& cons_in,
      qpevp.resize({zlo}, {zhi});
   }
 
+  auto qpsrc_t  = qpsrc.table();
+  auto qpevp_t  = qpevp.table();
+
+  auto gamaz_t  = gamaz.table();
+  auto zmid_t   = zmid.table();
+
+  Real gOcp = m_gOcp;
+
+  amrex::ParallelFor(nlev, [=] AMREX_GPU_DEVICE (int k) noexcept {
+    zmid_t(k)   = lowz + (k+0.5)*dz;
+    gamaz_t(k)  = gOcp*zmid_t(k);
+  });
+
+#if 0
+  amrex::ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int k, int j, int i) {
+    fluxbmk(l,j,i) = 0.0;
+    fluxtmk(l,j,i) = 0.0;
+  });
+
+  amrex::ParallelFor( box2d, [=] AMREX_GPU_DEVICE (int k, int l, int i0) {
+    mkwle (l,k) = 0.0;
+    mkwsb (l,k) = 0.0;
+    mkadv (l,k) = 0.0;
+    mkdiff(l,k) = 0.0;
+  });
+#endif
+
+  amrex::ParallelFor(nlev, [=] AMREX_GPU_DEVICE (int k) noexcept {
+    qpsrc_t(k) = 0.0;
+    qpevp_t(k) = 0.0;
+  });
+
+  Real gam3 = erf_gammafff(3.0             );
+  m_gamr1   = erf_gammafff(3.0+b_rain      );
+  m_gamr2   = erf_gammafff((5.0+b_rain)/2.0);
+  // m_gamr3 = erf_gammafff(4.0+b_rain      );
+  m_gams1   = erf_gammafff(3.0+b_snow      );
+  m_gams2   = erf_gammafff((5.0+b_snow)/2.0);
+  // m_gams3 = erf_gammafff(4.0+b_snow      );
+  m_gamg1   = erf_gammafff(3.0+b_grau      );
+  m_gamg2   = erf_gammafff((5.0+b_grau)/2.0);
+  // m_gamg3 = erf_gammafff(4.0+b_grau      );
+
+  if(round(gam3) != 2) {
+    std::cout << "cannot compute gamma-function in Microphysics::Init" << std::endl;
+    std::exit(-1);
+  }
+
+  m_defined = true;
+}
+
+void Microphysics::LoadState(const MultiFab& cons_in,
+                             const MultiFab& qc_in,
+                             const MultiFab& qi_in,
+                             const Real& dt_advance)
+{
+  BL_PROFILE("Microphysics::LoadState()");
+
+  dt = dt_advance;
+
   auto accrrc_t = accrrc.table();
   auto accrsi_t = accrsi.table();
   auto accrsc_t = accrsc.table();
@@ -90,22 +179,13 @@ void Microphysics::Init(const MultiFab& cons_in,
   auto rho1d_t  = rho1d.table();
   auto pres1d_t = pres1d.table();
   auto tabs1d_t = tabs1d.table();
-  auto qpsrc_t  = qpsrc.table();
-  auto qpevp_t  = qpevp.table();
 
-  auto gamaz_t  = gamaz.table();
-  auto zmid_t   = zmid.table();
-
-  Real gam3  = erf_gammafff(3.0             );
-  Real gamr1 = erf_gammafff(3.0+b_rain      );
-  Real gamr2 = erf_gammafff((5.0+b_rain)/2.0);
-  // Real gamr3 = erf_gammafff(4.0+b_rain      );
-  Real gams1 = erf_gammafff(3.0+b_snow      );
-  Real gams2 = erf_gammafff((5.0+b_snow)/2.0);
-  // Real gams3 = erf_gammafff(4.0+b_snow      );
-  Real gamg1 = erf_gammafff(3.0+b_grau      );
-  Real gamg2 = erf_gammafff((5.0+b_grau)/2.0);
-  // Real gamg3 = erf_gammafff(4.0+b_grau      );
+  Real gamr1 = m_gamr1;
+  Real gamr2 = m_gamr2;
+  Real gams1 = m_gams1;
+  Real gams2 = m_gams2;
+  Real gamg1 = m_gamg1;
+  Real gamg2 = m_gamg2;
 
   // get the temperature, density, theta, qt and qp from input
   for ( MFIter mfi(cons_in, false); mfi.isValid(); ++mfi) {
@@ -155,47 +235,16 @@ void Microphysics::Init(const MultiFab& cons_in,
   Real* rho_dptr      = rho_d.data();
   Real* rhotheta_dptr = rhotheta_d.data();
 
-  Real gOcp = m_gOcp;
-
   amrex::ParallelFor(nlev, [=] AMREX_GPU_DEVICE (int k) noexcept {
     Real pressure = getPgivenRTh(rhotheta_dptr[k]);
     rho1d_t(k)  = rho_dptr[k];
     pres1d_t(k) = pressure/100.;
     tabs1d_t(k) = getTgivenRandRTh(rho_dptr[k],rhotheta_dptr[k]);
-    zmid_t(k)   = lowz + (k+0.5)*dz;
-    gamaz_t(k)  = gOcp*zmid_t(k);
   });
 
   Diagnose();
 
-  // This has just been filled in Diagnose
-  // (We need values in ghost cells because qv enters into the getP... call)
-  qv_in.FillBoundary(m_geom.periodicity());
-
-#if 0
-  amrex::ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int k, int j, int i) {
-    fluxbmk(l,j,i) = 0.0;
-    fluxtmk(l,j,i) = 0.0;
-  });
-
-  amrex::ParallelFor( box2d, [=] AMREX_GPU_DEVICE (int k, int l, int i0) {
-    mkwle (l,k) = 0.0;
-    mkwsb (l,k) = 0.0;
-    mkadv (l,k) = 0.0;
-    mkdiff(l,k) = 0.0;
-  });
-#endif
-
-  amrex::ParallelFor(nlev, [=] AMREX_GPU_DEVICE (int k) noexcept {
-    qpsrc_t(k) = 0.0;
-    qpevp_t(k) = 0.0;
-  });
-
-  if(round(gam3) != 2) {
-    std::cout << "cannot compute gamma-function in Microphysics::Init" << std::endl;
-    std::exit(-1);
-  }
-
+  // The coefficients depend on the profiles above so are remade every time
   amrex::ParallelFor(nlev, [=] AMREX_GPU_DEVICE (int k) noexcept {
 
     Real pratio = sqrt(1.29 / rho1d_t(k));
@@ -2,6 +2,7 @@
 #include "Microphysics.H"
 #include "IndexDefines.H"
 #include "TileNoZ.H"
+#include "ERF_BatchedFillBoundary.H"
 
 void Microphysics::Update(amrex::MultiFab& cons_in,
                           amrex::MultiFab& qv_in,
@@ -42,14 +43,16 @@ void Microphysics::Update(amrex::MultiFab& cons_in,
      });
   }
 
-  // fill the boundary
-  cons_in.FillBoundary(m_geom.periodicity());
-  qv_in.FillBoundary(m_geom.periodicity());
-  qc_in.FillBoundary(m_geom.periodicity());
-  qi_in.FillBoundary(m_geom.periodicity());
-  qrain_in. FillBoundary(m_geom.periodicity());
-  qsnow_in. FillBoundary(m_geom.periodicity());
-  qgraup_in.FillBoundary(m_geom.periodicity());
+  // fill the boundary -- these all share the same grids so go out in one exchange
+  BatchedFillBoundary fb;
+  fb.add(cons_in);
+  fb.add(qv_in);
+  fb.add(qc_in);
+  fb.add(qi_in);
+  fb.add(qrain_in);
+  fb.add(qsnow_in);
+  fb.add(qgraup_in);
+  fb.fill(m_geom.periodicity());
 }
 
 
@@ -157,3 +157,61 @@ ERF::estTimeStep(int level, long& dt_fast_ratio) const
     }
   }
 }
+
+// Number of acoustic substeps for one RK stage when the substeps are adaptive (fast_cfl > 0).
+// This uses the same sound-speed estimate as estTimeStep but on the stage data,
+// with the velocity averaged from the momenta on the faces
+int
+ERF::estFastSubsteps (int level, const Vector<MultiFab>& S_stage, Real stage_dt) const
+{
+    BL_PROFILE("ERF::estFastSubsteps()");
+
+    auto const dxinv = geom[level].InvCellSizeArray();
+
+    const MultiFab& cons = S_stage[IntVar::cons];
+
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    for (MFIter mfi(cons,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox() & grids_to_evolve[level][mfi.index()];
+
+        auto const& s     = cons.const_array(mfi);
+        auto const& rho_u = S_stage[IntVar::xmom].const_array(mfi);
+        auto const& rho_v = S_stage[IntVar::ymom].const_array(mfi);
+        auto const& rho_w = S_stage[IntVar::zmom].const_array(mfi);
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            const Real rho = s(i, j, k, Rho_comp);
+
+            // NOTE: as in estTimeStep we only use the partial pressure of the dry air
+            Real pressure = getPgivenRTh(s(i, j, k, RhoTheta_comp));
+            Real c = std::sqrt(Gamma * pressure / rho);
+
+            Real u = 0.5 * (rho_u(i,j,k) + rho_u(i+1,j  ,k  )) / rho;
+            Real v = 0.5 * (rho_v(i,j,k) + rho_v(i  ,j+1,k  )) / rho;
+            Real w = 0.5 * (rho_w(i,j,k) + rho_w(i  ,j  ,k+1)) / rho;
+
+            return { amrex::max((amrex::Math::abs(u)+c)*dxinv[0],
+                                (amrex::Math::abs(v)+c)*dxinv[1],
+                                (amrex::Math::abs(w)+c)*dxinv[2]) };
+        });
+    }
+
+    Real fast_inv = amrex::get<0>(reduce_data.value(reduce_op));
+    ParallelDescriptor::ReduceRealMax(fast_inv);
+
+    int nsub = static_cast<int>(std::ceil(stage_dt * fast_inv / fast_cfl));
+    nsub = amrex::max(nsub, 1);
+
+    if (verbose > 1) {
+        amrex::Print() << "Acoustic substeps at level " << level << " for stage dt " << stage_dt
+                       << ": " << nsub << " (fast cfl " << fast_cfl << ")" << std::endl;
+    }
+
+    return nsub;
+}
@@ -116,8 +116,12 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
     FillPatch(lev, time, {&vars_old[lev][Vars::cons], &vars_old[lev][Vars::xvel],
                           &vars_old[lev][Vars::yvel], &vars_old[lev][Vars::zvel]});
 
+    AdvanceBuffers& buffers = *advance_buffers_lev[lev];
+
     MultiFab* S_crse;
-    MultiFab rU_crse, rV_crse, rW_crse;
+    MultiFab& rU_crse = buffers.rU_crse;
+    MultiFab& rV_crse = buffers.rV_crse;
+    MultiFab& rW_crse = buffers.rW_crse;
 
     if (lev > 0)
     {
@@ -127,9 +131,7 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
         MultiFab& V_crse = vars_old[lev-1][Vars::yvel];
         MultiFab& W_crse = vars_old[lev-1][Vars::zvel];
 
-        rU_crse.define(U_crse.boxArray(), U_crse.DistributionMap(), 1, U_crse.nGrow());
-        rV_crse.define(V_crse.boxArray(), V_crse.DistributionMap(), 1, V_crse.nGrow());
-        rW_crse.define(W_crse.boxArray(), W_crse.DistributionMap(), 1, W_crse.nGrow());
+        buffers.define_crse(U_crse, V_crse, W_crse);
 
         VelocityToMomentum(grids_to_evolve[lev],
                            U_crse, U_crse.nGrowVect(),
@@ -153,13 +155,8 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
         ifr.define(S_old.boxArray(), S_old.DistributionMap(), Geom(lev), local_ref_ratio);
     }
 
-    const BoxArray&            ba = S_old.boxArray();
-    const DistributionMapping& dm = S_old.DistributionMap();
-
-    int nvars = S_old.nComp();
-
     // Place-holder for source array -- for now just set to 0
-    MultiFab source(ba,dm,nvars,1);
+    MultiFab& source = buffers.source;
     source.setVal(0.0);
 #if defined(ERF_USE_WARM_NO_PRECIP)
     Real tau_cond = solverChoice.tau_cond;
@@ -167,12 +164,8 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
     condensation_source(source, S_new, tau_cond, c_p);
 #endif
 
-    // We don't need to call FillPatch on cons_mf because we have fillpatch'ed S_old above
-    MultiFab cons_mf(ba,dm,nvars,S_old.nGrowVect());
-    MultiFab::Copy(cons_mf,S_old,0,0,S_old.nComp(),S_old.nGrowVect());
-
-    // Define Multifab for buoyancy term -- only added to vertical velocity
-    MultiFab buoyancy(W_old.boxArray(),W_old.DistributionMap(),1,1);
+    // Buoyancy term -- only added to vertical velocity
+    MultiFab& buoyancy = buffers.buoyancy;
 
     // *****************************************************************
     // Update the cell-centered state and face-based velocity using
@@ -190,8 +183,18 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
     //          W_new    (z-velocity on z-faces)
     // *****************************************************************
 
+    // We have fillpatch'ed S_old above. The boundary conditions applied inside erf_advance
+    // only write ghost cells, except that with real data the wrfbdy relaxation zone is
+    // filled in the valid region -- so only then do we hand erf_advance a copy of S_old
+    MultiFab* cons_mf = &S_old;
+    if (init_type == "real") {
+        cons_mf = &buffers.cons_copy;
+        MultiFab::Copy(*cons_mf,S_old,0,0,S_old.nComp(),S_old.nGrowVect());
+        StateBufferStats::add_copy(S_old, S_old.nComp(), S_old.nGrowVect());
+    }
+
     erf_advance(lev,
-                cons_mf, S_new,
+                *cons_mf, S_new,
                 U_old, V_old, W_old,
                 U_new, V_new, W_new,
                 rU_old[lev], rV_old[lev], rW_old[lev],
@@ -211,11 +214,8 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
                grids_to_evolve[lev],
                Geom(lev),
                dt_lev);
-    micro.Cloud();
-    micro.Diagnose();
-    micro.IceFall();
-    micro.Precip();
-    micro.MicroPrecipFall();
+    micro.ColumnProc();
+    micro.PrecipFall(2);
     micro.Update(S_new,
                  qv[lev],
                  qc[lev],
@@ -224,4 +224,9 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
                  qsnow[lev],
                  qgraup[lev]);
 #endif
+
+    if (verbose > 1) {
+        StateBufferStats::print(lev);
+    }
+    StateBufferStats::reset();
 }
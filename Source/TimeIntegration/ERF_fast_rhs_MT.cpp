@@ -20,6 +20,7 @@ void erf_fast_rhs_MT (int step, int /*level*/,
                       const MultiFab& S_stg_prim,                    // Primitive version of S_stg_data[IntVar::cons]
                       const MultiFab& pi_stg,                        // Exner function evaluated at last RK stg
                       const MultiFab& fast_coeffs,                   // Coeffs for tridiagonal solve
+                      FastRhsScratch& fast_scratch,                  // Persistent scratch MultiFabs
                       Vector<MultiFab>& S_data,                      // S_sum = state at end of this substep
                       Vector<MultiFab>& S_scratch,                   // S_sum_old at most recent fast timestep for (rho theta)
                       const amrex::Geometry geom,
@@ -59,9 +60,6 @@ void erf_fast_rhs_MT (int step, int /*level*/,
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
 
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
     MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
     MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
@@ -70,7 +68,7 @@ void erf_fast_rhs_MT (int step, int /*level*/,
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    MultiFab& extrap = fast_scratch.extrap;
 
     // *************************************************************************
     // Define updates in the current RK stg
@@ -78,12 +76,6 @@ void erf_fast_rhs_MT (int step, int /*level*/,
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-    {
-    FArrayBox temp_rhs_fab;
-
-    FArrayBox RHS_fab;
-    FArrayBox soln_fab;
-
     //  NOTE: we leave tiling off here for efficiency -- to make this loop work with tiling
     //        will require additional changes
     for ( MFIter mfi(S_stg_data[IntVar::cons],false); mfi.isValid(); ++mfi)
@@ -183,21 +175,10 @@ void erf_fast_rhs_MT (int step, int /*level*/,
         } // if step
         } // end profile
 
-        RHS_fab.resize(tbz,1);
-        soln_fab.resize(tbz,1);
-        temp_rhs_fab.resize(tbz,2);
+        auto const& RHS_a        = fast_scratch.RHS.array(mfi);
+        auto const& soln_a       = fast_scratch.soln.array(mfi);
+        auto const& temp_rhs_arr = fast_scratch.temp_rhs.array(mfi);
 
-        Elixir rCeli        =      RHS_fab.elixir();
-        Elixir sCeli        =     soln_fab.elixir();
-        Elixir temp_rhs_eli = temp_rhs_fab.elixir();
-
-        auto const& RHS_a        =      RHS_fab.array();
-        auto const& soln_a       =     soln_fab.array();
-        auto const& temp_rhs_arr = temp_rhs_fab.array();
-
-        auto const&     coeffA_a =     coeff_A_mf.array(mfi);
-        auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -410,78 +391,27 @@ void erf_fast_rhs_MT (int step, int /*level*/,
         amrex::Box b2d = tbz; // Copy constructor
         b2d.setRange(2,0);
 
-        auto const lo = amrex::lbound(bx);
         auto const hi = amrex::ubound(bx);
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-
-#ifdef AMREX_USE_GPU
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
         {
             // Moving terrain
             Real rho_on_bdy = 0.5 * ( prev_cons(i,j,0) + prev_cons(i,j,-1) );
             RHS_a(i,j,0) = rho_on_bdy * zp_t_arr(i,j,0);
 
-            soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-
             // w_khi = 0
-            RHS_a(i,j,hi.z+1)     =  0.0;
-
-            for (int k = 1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
-
-            for (int k = hi.z; k >= 0; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-            }
-
-           // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-            cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
+            RHS_a(i,j,hi.z+1) =  0.0;
         });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
 
-                 Real rho_on_bdy = 0.5 * ( prev_cons(i,j,0) + prev_cons(i,j,-1) );
-                 RHS_a(i,j,0) = rho_on_bdy * zp_t_arr(i,j,0);
-
-                 soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-             }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                 }
-             }
-        }
+        fast_scratch.tridiag.solve(mfi, bx, RHS_a, soln_a);
 
         // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
+            cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
+        });
         } // end profile
 
         {
@@ -553,5 +483,4 @@ void erf_fast_rhs_MT (int step, int /*level*/,
         });
         } // end profile
     } // mfi
-    }
 }
@@ -19,6 +19,7 @@ void erf_fast_rhs_N (int step, int /*level*/,
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVar::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
                      const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     FastRhsScratch& fast_scratch,                   // Persistent scratch MultiFabs
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const amrex::Geometry geom,
@@ -49,16 +50,10 @@ void erf_fast_rhs_N (int step, int /*level*/,
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
 
-    const auto& ba = S_stage_data[IntVar::cons].boxArray();
-    const auto& dm = S_stage_data[IntVar::cons].DistributionMap();
+    MultiFab& Delta_rho_w     = fast_scratch.Delta_rho_w;
+    MultiFab& Delta_rho       = fast_scratch.Delta_rho;
+    MultiFab& Delta_rho_theta = fast_scratch.Delta_rho_theta;
 
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
-
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
     MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
     MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
@@ -68,14 +63,14 @@ void erf_fast_rhs_N (int step, int /*level*/,
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
     // This will hold theta extrapolated forward in time
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    MultiFab& extrap = fast_scratch.extrap;
 
     // This will hold the update for (rho) and (rho theta)
-    MultiFab temp_rhs(S_stage_data[IntVar::zmom].boxArray(),S_stage_data[IntVar::zmom].DistributionMap(),2,0);
+    MultiFab& temp_rhs = fast_scratch.temp_rhs;
 
     // This will hold the new x- and y-momenta temporarily (so that we don't overwrite values we need when tiling)
-    MultiFab temp_cur_xmom(S_stage_data[IntVar::xmom].boxArray(),S_stage_data[IntVar::xmom].DistributionMap(),1,0);
-    MultiFab temp_cur_ymom(S_stage_data[IntVar::ymom].boxArray(),S_stage_data[IntVar::ymom].DistributionMap(),1,0);
+    MultiFab& temp_cur_xmom = fast_scratch.temp_cur_xmom;
+    MultiFab& temp_cur_ymom = fast_scratch.temp_cur_ymom;
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -288,23 +283,11 @@ void erf_fast_rhs_N (int step, int /*level*/,
         const Array4<const Real>& mf_u = mapfac_u->const_array(mfi);
         const Array4<const Real>& mf_v = mapfac_v->const_array(mfi);
 
-        FArrayBox RHS_fab;
-        RHS_fab.resize(tbz,1);
-
-        FArrayBox soln_fab;
-        soln_fab.resize(tbz,1);
-
-        auto const& RHS_a  = RHS_fab.array();
-        auto const& soln_a = soln_fab.array();
+        auto const& RHS_a  = fast_scratch.RHS.array(mfi);
+        auto const& soln_a = fast_scratch.soln.array(mfi);
 
         auto const& temp_rhs_arr = temp_rhs.array(mfi);
 
-        Elixir rCeli       = RHS_fab.elixir();
-        Elixir sCeli       = soln_fab.elixir();
-
-        auto const&     coeffA_a =     coeff_A_mf.array(mfi);
-        auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -398,7 +381,6 @@ void erf_fast_rhs_N (int step, int /*level*/,
 
         {
         BL_PROFILE("fast_rhs_b2d_loop");
-#ifdef AMREX_USE_GPU
         auto const hi = amrex::ubound(bx);
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
         {
@@ -408,61 +390,14 @@ void erf_fast_rhs_N (int step, int /*level*/,
           // w_khi = 0
           // Note that if we ever change this, we will need to include it in avg_zmom at the top
           RHS_a   (i,j,hi.z+1) =  0.0;
+        });
 
-          // w = 0 at k = 0
-          soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-          cur_zmom(i,j,0) = stage_zmom(i,j,0) + soln_a(i,j,0);
-
-          for (int k = 1; k <= hi.z+1; k++) {
-              soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-          }
-          cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-          for (int k = hi.z; k >= 0; k--) {
-              soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-              cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-          }
-        }); // b2d
-#else
-        auto const lo = amrex::lbound(bx);
-        auto const hi = amrex::ubound(bx);
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,0) =  0.0;
-                soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-            }
-        }
-        // Note that if we ever change this, we will need to include it in avg_zmom at the top
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,hi.z+1) =  0.0;
-            }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                }
-            }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                    cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-                }
-            }
-        }
-#endif
+        fast_scratch.tridiag.solve(mfi, bx, RHS_a, soln_a);
+
+        ParallelFor(tbz, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+          cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
+        });
         } // end profile
 
         // **************************************************************************
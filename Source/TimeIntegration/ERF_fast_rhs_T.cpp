@@ -20,6 +20,7 @@ void erf_fast_rhs_T (int step, int /*level*/,
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVar::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
                      const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     FastRhsScratch& fast_scratch,                   // Persistent scratch MultiFabs
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const amrex::Geometry geom,
@@ -52,21 +53,16 @@ void erf_fast_rhs_T (int step, int /*level*/,
     Real dxi = dxInv[0];
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
-    const auto& ba = S_stage_data[IntVar::cons].boxArray();
-    const auto& dm = S_stage_data[IntVar::cons].DistributionMap();
 
-    MultiFab Delta_rho_u(    convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab Delta_rho_v(    convert(ba,IntVect(0,1,0)), dm, 1, 1);
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    MultiFab& Delta_rho_u     = fast_scratch.Delta_rho_u;
+    MultiFab& Delta_rho_v     = fast_scratch.Delta_rho_v;
+    MultiFab& Delta_rho_w     = fast_scratch.Delta_rho_w;
+    MultiFab& Delta_rho       = fast_scratch.Delta_rho;
+    MultiFab& Delta_rho_theta = fast_scratch.Delta_rho_theta;
 
-    MultiFab New_rho_u(convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab New_rho_v(convert(ba,IntVect(0,1,0)), dm, 1, 1);
+    MultiFab& New_rho_u = fast_scratch.New_rho_u;
+    MultiFab& New_rho_v = fast_scratch.New_rho_v;
 
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
     MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
     MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
@@ -75,7 +71,7 @@ void erf_fast_rhs_T (int step, int /*level*/,
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    MultiFab& extrap = fast_scratch.extrap;
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -336,24 +332,10 @@ void erf_fast_rhs_T (int step, int /*level*/,
         // Initialize New_rho_u/v/w to Delta_rho_u/v/w so that
         // the ghost cells in New_rho_u/v/w will match old_drho_u/v/w
 
-        FArrayBox temp_rhs_fab;
-        FArrayBox RHS_fab;
-        FArrayBox soln_fab;
-        RHS_fab.resize(tbz,1);
-        soln_fab.resize(tbz,1);
-        temp_rhs_fab.resize(tbz,2);
+        auto const& RHS_a        = fast_scratch.RHS.array(mfi);
+        auto const& soln_a       = fast_scratch.soln.array(mfi);
+        auto const& temp_rhs_arr = fast_scratch.temp_rhs.array(mfi);
 
-        Elixir rCeli        =      RHS_fab.elixir();
-        Elixir sCeli        =     soln_fab.elixir();
-        Elixir temp_rhs_eli = temp_rhs_fab.elixir();
-
-        auto const& RHS_a        =      RHS_fab.array();
-        auto const& soln_a       =     soln_fab.array();
-        auto const& temp_rhs_arr = temp_rhs_fab.array();
-
-        auto const&     coeffA_a =     coeff_A_mf.array(mfi);
-        auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -486,67 +468,23 @@ void erf_fast_rhs_T (int step, int /*level*/,
         amrex::Box b2d = tbz; // Copy constructor
         b2d.setRange(2,0);
 
-        auto const lo = amrex::lbound(bx);
         auto const hi = amrex::ubound(bx);
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-#ifdef AMREX_USE_GPU
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
         {
             // w_0 = 0  w_khi = 0
             RHS_a(i,j     ,0) =  0.0;
             RHS_a(i,j,hi.z+1) =  0.0;
+        });
 
-            // w = 0 at k = 0
-            soln_a(i,j,0) = 0.;
+        fast_scratch.tridiag.solve(mfi, bx, RHS_a, soln_a);
 
-            for (int k = 1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
             cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            for (int k = hi.z; k >= 0; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-            }
         });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a (i,j,0) =  0.0;
-               soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-           }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= (coeffC_a(i,j,k) * inv_coeffB_a(i,j,k)) * soln_a(i,j,k+1);
-                 }
-             }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
         } // end profile
 
         {
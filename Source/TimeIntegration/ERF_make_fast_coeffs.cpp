@@ -7,6 +7,170 @@
 
 using namespace amrex;
 
+namespace {
+
+// Forward elimination of the tridiagonal system in each column of bx with w = 0
+// on the bottom and top faces; on exit B holds the inverse of the pivots
+void factor_fast_coeffs (const Box& bx, const Box& bx_shrunk_in_k,
+                         const Array4<Real>& coeffA_a,
+                         const Array4<Real>& coeffB_a,
+                         const Array4<Real>& coeffC_a)
+{
+    amrex::Box b2d = surroundingNodes(bx,2);
+    b2d.setRange(2,0);
+
+    auto const hi = amrex::ubound(bx);
+
+    {
+    BL_PROFILE("make_coeffs_b2d_loop");
+#ifdef AMREX_USE_GPU
+    ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) {
+      // w_0 = 0
+      coeffA_a(i,j,0) =  0.0;
+      coeffB_a(i,j,0) =  1.0;
+      coeffC_a(i,j,0) =  0.0;
+
+      // w_khi = 0
+      coeffA_a(i,j,hi.z+1) =  0.0;
+      coeffB_a(i,j,hi.z+1) =  1.0;
+      coeffC_a(i,j,hi.z+1) =  0.0;
+
+      // w = 0 at k = 0
+      Real bet = coeffB_a(i,j,0);
+
+      for (int k = 1; k <= hi.z+1; k++) {
+          Real gam = coeffC_a(i,j,k-1) / bet;
+          bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam;
+          coeffB_a(i,j,k) = bet;
+      }
+    });
+#else
+    auto const lo = amrex::lbound(bx);
+    for (int j = lo.y; j <= hi.y; ++j) {
+        AMREX_PRAGMA_SIMD
+        for (int i = lo.x; i <= hi.x; ++i) {
+            coeffA_a(i,j,0) =  0.0;
+            coeffB_a(i,j,0) =  1.0;
+            coeffC_a(i,j,0) =  0.0;
+        }
+    }
+    for (int j = lo.y; j <= hi.y; ++j) {
+        AMREX_PRAGMA_SIMD
+        for (int i = lo.x; i <= hi.x; ++i) {
+            coeffA_a(i,j,hi.z+1) =  0.0;
+            coeffB_a(i,j,hi.z+1) =  1.0;
+            coeffC_a(i,j,hi.z+1) =  0.0;
+        }
+    }
+    for (int k = lo.z+1; k <= hi.z+1; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            AMREX_PRAGMA_SIMD
+            for (int i = lo.x; i <= hi.x; ++i) {
+                Real gam = coeffC_a(i,j,k-1) / coeffB_a(i,j,k-1);
+                Real bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam;
+                coeffB_a(i,j,k) = bet;
+            }
+        }
+    }
+#endif
+    } // end profile
+
+    // In the end we save the inverse of the diagonal (B) coefficient
+    {
+    BL_PROFILE("make_coeffs_invert");
+        ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            coeffB_a(i,j,k) = 1.0 / coeffB_a(i,j,k);
+        });
+    } // end profile
+}
+
+} // namespace
+
+void make_fast_stage_coeffs (int /*level*/,
+                             BoxArray& grids_to_evolve,
+                             MultiFab& stage_coeffs,
+                             Vector<MultiFab>& S_stage_data,                 // S_bar = S^n, S^* or S^**
+                             const MultiFab& S_stage_prim,
+                             const MultiFab& pi_stage,                       // Exner function evaluted at least stage
+                             const amrex::Geometry geom,
+                             const SolverChoice& solverChoice,
+                             const MultiFab* r0, const MultiFab* pi0)
+{
+    BL_PROFILE_VAR("make_fast_stage_coeffs()",make_fast_stage_coeffs);
+
+    Real c_v = solverChoice.c_p - R_d;
+
+    const GpuArray<Real, AMREX_SPACEDIM> dxInv = geom.InvCellSizeArray();
+
+    Real dzi = dxInv[2];
+
+    // Note that the notes use "g" to mean the magnitude of gravity, so it is positive
+    // We define halfg to match the notes (which is why we take the absolute value)
+    Real halfg = std::abs(0.5 * solverChoice.gravity);
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(S_stage_data[IntVar::cons],TileNoZ()); mfi.isValid(); ++mfi)
+    {
+        // Construct intersection of current tilebox and valid region for updating
+        Box bx = mfi.tilebox() & grids_to_evolve[mfi.index()];
+
+        Box tbz = surroundingNodes(bx,2);
+
+        const Array4<const Real> & stage_cons = S_stage_data[IntVar::cons].const_array(mfi);
+        const Array4<const Real> & prim       = S_stage_prim.const_array(mfi);
+
+        const Array4<const Real>& r0_ca       = r0->const_array(mfi);
+        const Array4<const Real>& pi0_ca      = pi0->const_array(mfi);
+        const Array4<const Real>& pi_stage_ca = pi_stage.const_array(mfi);
+
+        const Array4<Real>& stg_a = stage_coeffs.array(mfi);
+
+        //Note we don't act on the bottom or top boundaries of the domain
+        Box bx_shrunk_in_k = bx;
+        bx_shrunk_in_k.setSmall(2,tbz.smallEnd(2)+1);
+        bx_shrunk_in_k.setBig(2,tbz.bigEnd(2)-1);
+
+        ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            Real rhobar_lo, rhobar_hi, pibar_lo, pibar_hi;
+            rhobar_lo =  r0_ca(i,j,k-1);
+            rhobar_hi =  r0_ca(i,j,k  );
+             pibar_lo = pi0_ca(i,j,k-1);
+             pibar_hi = pi0_ca(i,j,k  );
+
+            Real pi_lo = pi_stage_ca(i,j,k-1,0);
+            Real pi_hi = pi_stage_ca(i,j,k  ,0);
+            Real pi_c =  0.5 * (pi_lo + pi_hi);
+
+            stg_a(i,j,k,FastStageCoeff::PiGrad) = Gamma * R_d * pi_c * dzi;
+
+            stg_a(i,j,k,FastStageCoeff::HseP) = halfg * R_d * rhobar_hi * pi_hi  /
+                                                (  c_v * pibar_hi * stage_cons(i,j,k,RhoTheta_comp) );
+            stg_a(i,j,k,FastStageCoeff::HseQ) = halfg * R_d * rhobar_lo * pi_lo  /
+                                                ( c_v  * pibar_lo * stage_cons(i,j,k-1,RhoTheta_comp) );
+
+#if defined(ERF_USE_MOISTURE)
+            Real q = 0.5 * ( prim(i,j,k,PrimQt_comp) + prim(i,j,k-1,PrimQt_comp)
+                            +prim(i,j,k,PrimQp_comp) + prim(i,j,k-1,PrimQp_comp) );
+            stg_a(i,j,k,FastStageCoeff::MoistFac) = 1.0 + q;
+#elif defined(ERF_USE_WARM_NO_PRECIP)
+            Real q = 0.5 * ( prim(i,j,k  ,PrimQv_comp) + prim(i,j,k  ,PrimQc_comp) +
+                             prim(i,j,k-1,PrimQv_comp) + prim(i,j,k-1,PrimQc_comp) );
+            stg_a(i,j,k,FastStageCoeff::MoistFac) = 1.0 + q;
+#else
+            stg_a(i,j,k,FastStageCoeff::MoistFac) = 1.0;
+#endif
+
+            stg_a(i,j,k,FastStageCoeff::ThetaLo ) = 0.5 * ( prim(i,j,k-2,PrimTheta_comp) + prim(i,j,k-1,PrimTheta_comp) );
+            stg_a(i,j,k,FastStageCoeff::ThetaMid) = 0.5 * ( prim(i,j,k-1,PrimTheta_comp) + prim(i,j,k  ,PrimTheta_comp) );
+            stg_a(i,j,k,FastStageCoeff::ThetaHi ) = 0.5 * ( prim(i,j,k  ,PrimTheta_comp) + prim(i,j,k+1,PrimTheta_comp) );
+        });
+    } // mfi
+}
+
 void make_fast_coeffs (int /*level*/,
                        BoxArray& grids_to_evolve,
                        MultiFab& fast_coeffs,
@@ -53,8 +217,6 @@ void make_fast_coeffs (int /*level*/,
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-    {
-
     for ( MFIter mfi(S_stage_data[IntVar::cons],TileNoZ()); mfi.isValid(); ++mfi)
     {
         const Box& valid_bx = grids_to_evolve[mfi.index()];
@@ -72,15 +234,11 @@ void make_fast_coeffs (int /*level*/,
         const Array4<const Real>& r0_ca       = r0->const_array(mfi);
         const Array4<const Real>& pi0_ca      = pi0->const_array(mfi); const Array4<const Real>& pi_stage_ca = pi_stage.const_array(mfi);
 
-        FArrayBox gam_fab; gam_fab.resize(surroundingNodes(bx,2),1);
-        Elixir gEli = gam_fab.elixir();
-
         auto const& coeffA_a  = coeff_A_mf.array(mfi);
         auto const& coeffB_a  = coeff_B_mf.array(mfi);
         auto const& coeffC_a  = coeff_C_mf.array(mfi);
         auto const& coeffP_a  = coeff_P_mf.array(mfi);
         auto const& coeffQ_a  = coeff_Q_mf.array(mfi);
-        auto const&    gam_a  = gam_fab.array();
 
         // *********************************************************************
         // *********************************************************************
@@ -200,73 +358,116 @@ void make_fast_coeffs (int /*level*/,
             });
         }
 
-        amrex::Box b2d = tbz; // Copy constructor
-        b2d.setRange(2,0);
+        factor_fast_coeffs(bx, bx_shrunk_in_k, coeffA_a, coeffB_a, coeffC_a);
+    } // mfi
+}
 
-        auto const hi = amrex::ubound(bx);
+void make_fast_coeffs_from_stage (int /*level*/,
+                                  BoxArray& grids_to_evolve,
+                                  MultiFab& fast_coeffs,
+                                  const MultiFab& stage_coeffs,        // built by make_fast_stage_coeffs
+                                  const amrex::Geometry geom,
+                                  const SolverChoice& solverChoice,
+                                  std::unique_ptr<MultiFab>& detJ_cc,
+                                  amrex::Real dtau)
+{
+    BL_PROFILE_VAR("make_fast_coeffs_from_stage()",make_fast_coeffs_from_stage);
 
-        {
-        BL_PROFILE("make_coeffs_b2d_loop");
-#ifdef AMREX_USE_GPU
-        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) {
-          // w_0 = 0
-          coeffA_a(i,j,0) =  0.0;
-          coeffB_a(i,j,0) =  1.0;
-          coeffC_a(i,j,0) =  0.0;
-
-          // w_khi = 0
-          coeffA_a(i,j,hi.z+1) =  0.0;
-          coeffB_a(i,j,hi.z+1) =  1.0;
-          coeffC_a(i,j,hi.z+1) =  0.0;
-
-          // w = 0 at k = 0
-          Real bet = coeffB_a(i,j,0);
-
-          for (int k = 1; k <= hi.z+1; k++) {
-              gam_a(i,j,k) = coeffC_a(i,j,k-1) / bet;
-              bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam_a(i,j,k);
-              coeffB_a(i,j,k) = bet;
-          }
-        });
-#else
-        auto const lo = amrex::lbound(bx);
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                coeffA_a(i,j,0) =  0.0;
-                coeffB_a(i,j,0) =  1.0;
-                coeffC_a(i,j,0) =  0.0;
-            }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                coeffA_a(i,j,hi.z+1) =  0.0;
-                coeffB_a(i,j,hi.z+1) =  1.0;
-                coeffC_a(i,j,hi.z+1) =  0.0;
-            }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    gam_a(i,j,k) = coeffC_a(i,j,k-1) / coeffB_a(i,j,k-1);
-                    Real bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam_a(i,j,k);
-                    coeffB_a(i,j,k) = bet;
-                }
-            }
-        }
+    // Only used with moving terrain
+    AMREX_ALWAYS_ASSERT(solverChoice.use_terrain && solverChoice.terrain_type == 1);
+
+    // beta_s = -1.0 : fully explicit
+    // beta_s =  1.0 : fully implicit
+    Real beta_s = 0.1;
+    Real beta_2 = 0.5 * (1.0 + beta_s);  // multiplies implicit terms
+
+    const GpuArray<Real, AMREX_SPACEDIM> dxInv = geom.InvCellSizeArray();
+
+    Real dzi = dxInv[2];
+
+    MultiFab coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
+    MultiFab coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
+    MultiFab coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
+    MultiFab coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
+    MultiFab coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
+
+    // *************************************************************************
+    // Set gravity as a vector
+    const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
+    const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
+
+    // *************************************************************************
+    // Define updates in the current RK stage
+    // *************************************************************************
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-        } // end profile
+    for ( MFIter mfi(fast_coeffs,TileNoZ()); mfi.isValid(); ++mfi)
+    {
+        const Box& valid_bx = grids_to_evolve[mfi.index()];
+
+        // Construct intersection of current tilebox and valid region for updating
+        Box bx = enclosedCells(mfi.tilebox()) & valid_bx;
+
+        Box tbz = surroundingNodes(bx,2);
+
+        const Array4<const Real>& detJ   = detJ_cc->const_array(mfi);
+
+        const Array4<const Real>& stg_a = stage_coeffs.const_array(mfi);
+
+        auto const& coeffA_a  = coeff_A_mf.array(mfi);
+        auto const& coeffB_a  = coeff_B_mf.array(mfi);
+        auto const& coeffC_a  = coeff_C_mf.array(mfi);
+        auto const& coeffP_a  = coeff_P_mf.array(mfi);
+        auto const& coeffQ_a  = coeff_Q_mf.array(mfi);
+
+        // *********************************************************************
+        // *********************************************************************
+        // *********************************************************************
+
+        Box bx_shrunk_in_k = bx;
+        int klo = tbz.smallEnd(2);
+        int khi = tbz.bigEnd(2);
+        bx_shrunk_in_k.setSmall(2,klo+1);
+        bx_shrunk_in_k.setBig(2,khi-1);
 
-        // In the end we save the inverse of the diagonal (B) coefficient
+        // Note that the notes use "g" to mean the magnitude of gravity, so it is positive
+        // We set grav_gpu[2] to be the vector component which is negative
+        // We define halfg to match the notes (which is why we take the absolute value)
+        Real halfg = std::abs(0.5 * grav_gpu[2]);
+
+        //Note we don't act on the bottom or top boundaries of the domain
+        ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-        BL_PROFILE("make_coeffs_invert");
-            ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-            {
-                coeffB_a(i,j,k) = 1.0 / coeffB_a(i,j,k);
-            });
-        } // end profile
+             Real     detJ_on_kface = 0.5 * (detJ(i,j,k) + detJ(i,j,k-1));
+             Real inv_detJ_on_kface = 1. / detJ_on_kface;
+
+             Real coeff_P = -(stg_a(i,j,k,FastStageCoeff::PiGrad) * inv_detJ_on_kface)
+                           +  stg_a(i,j,k,FastStageCoeff::HseP);
+
+             Real coeff_Q =   stg_a(i,j,k,FastStageCoeff::PiGrad) * inv_detJ_on_kface
+                           +  stg_a(i,j,k,FastStageCoeff::HseQ);
+
+             coeffP_a(i,j,k) = coeff_P;
+             coeffQ_a(i,j,k) = coeff_Q;
+
+#if defined(ERF_USE_MOISTURE) || defined(ERF_USE_WARM_NO_PRECIP)
+            coeff_P /= stg_a(i,j,k,FastStageCoeff::MoistFac);
+            coeff_Q /= stg_a(i,j,k,FastStageCoeff::MoistFac);
+#endif
+
+            Real theta_t_lo  = stg_a(i,j,k,FastStageCoeff::ThetaLo);
+            Real theta_t_mid = stg_a(i,j,k,FastStageCoeff::ThetaMid);
+            Real theta_t_hi  = stg_a(i,j,k,FastStageCoeff::ThetaHi);
+
+            // LHS for tri-diagonal system
+            Real D = dtau * dtau * beta_2 * beta_2 * dzi;
+            coeffA_a(i,j,k) = D * ( halfg - coeff_Q * theta_t_lo );
+            coeffC_a(i,j,k) = D * (-halfg + coeff_P * theta_t_hi );
+
+            coeffB_a(i,j,k) = detJ_on_kface + D * (coeff_Q - coeff_P) * theta_t_mid;
+        });
+
+        factor_fast_coeffs(bx, bx_shrunk_in_k, coeffA_a, coeffB_a, coeffC_a);
     } // mfi
-    } // omp
 }
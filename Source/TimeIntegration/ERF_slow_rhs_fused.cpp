@@ -0,0 +1,318 @@
+#include <AMReX_MultiFab.H>
+#include <AMReX_ArrayLim.H>
+#include <AMReX_GpuContainers.H>
+#include <TimeIntegration.H>
+#include <IndexDefines.H>
+
+using namespace amrex;
+
+/**
+ * Fused slow RHS for the non-terrain, second-order, non-WENO case.
+ *
+ * A single kernel is launched over the nodal version of the tile.  The thread for
+ * (i,j,k) builds, from values it loads once and keeps in registers,
+ *   - the RHS of (rho) and (rho theta) at cell (i,j,k) together with the face fluxes
+ *     accumulated in avg_xmom/avg_ymom/avg_zmom,
+ *   - the RHS of x-, y- and z-momentum on the faces (i,j,k) of the tile,
+ * including the pressure gradient, buoyancy, geostrophic/ABL forcing, Coriolis and
+ * Rayleigh damping.  The arithmetic is the same as in AdvectionSrcForRhoAndTheta,
+ * AdvectionSrcForMom and erf_slow_rhs_pre so without diffusion the answer is unchanged;
+ * the diffusive terms are added afterwards by the caller.
+ *
+ * pp_arr is the perturbational pressure on the tile grown by one cell in x and y.
+ */
+void erf_fused_slow_rhs_N (const Box& bx, const Box& valid_bx,
+                           const Box& tbx, const Box& tby, const Box& tbz,
+                           const Array4<Real>& cell_rhs,
+                           const Array4<Real>& rho_u_rhs,
+                           const Array4<Real>& rho_v_rhs,
+                           const Array4<Real>& rho_w_rhs,
+                           const Array4<Real>& avg_xmom,
+                           const Array4<Real>& avg_ymom,
+                           const Array4<Real>& avg_zmom,
+                           const Array4<const Real>& cell_data,
+                           const Array4<const Real>& cell_prim,
+                           const Array4<const Real>& u,
+                           const Array4<const Real>& v,
+                           const Array4<const Real>& w,
+                           const Array4<const Real>& rho_u,
+                           const Array4<const Real>& rho_v,
+                           const Array4<const Real>& rho_w,
+                           const Array4<const Real>& pp_arr,
+                           const Array4<const Real>& buoyancy_fab,
+                           const Array4<const Real>& src_arr,
+                           const Array4<const Real>& mf_m,
+                           const Array4<const Real>& mf_u,
+                           const Array4<const Real>& mf_v,
+                           const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                           const SolverChoice& solverChoice,
+                           const int domhi_z,
+                           const Real* dptr_rayleigh_tau, const Real* dptr_rayleigh_ubar,
+                           const Real* dptr_rayleigh_vbar, const Real* dptr_rayleigh_wbar,
+                           const Real* dptr_rayleigh_thetabar)
+{
+    BL_PROFILE("erf_fused_slow_rhs_N()");
+
+    AMREX_ALWAYS_ASSERT(tbz.smallEnd(2) > 0);
+
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    // We note that valid_bx is the actual grid, while bx may be a tile within that grid
+    const auto& vbx_hi = amrex::ubound(valid_bx);
+
+    // The faces on which we set rho_w_rhs = 0 (no forcing term at the top and bottom boundaries)
+    Box b2d = tbz;
+    b2d.setSmall(2,0);
+    b2d.setBig(2,0);
+
+    // Copy the forcing options into locals so we don't capture all of solverChoice
+    const Real fac = 1.0;
+    const bool l_use_coriolis = solverChoice.use_coriolis;
+    const Real l_coriolis_factor = solverChoice.coriolis_factor;
+    const Real l_sinphi = solverChoice.sinphi;
+    const Real l_cosphi = solverChoice.cosphi;
+    const bool l_rayleigh_U = solverChoice.use_rayleigh_damping && solverChoice.rayleigh_damp_U;
+    const bool l_rayleigh_V = solverChoice.use_rayleigh_damping && solverChoice.rayleigh_damp_V;
+    const bool l_rayleigh_W = solverChoice.use_rayleigh_damping && solverChoice.rayleigh_damp_W;
+    const bool l_rayleigh_T = solverChoice.use_rayleigh_damping && solverChoice.rayleigh_damp_T;
+    const GpuArray<Real,AMREX_SPACEDIM> l_abl_pressure_grad{solverChoice.abl_pressure_grad[0],
+                                                            solverChoice.abl_pressure_grad[1],
+                                                            solverChoice.abl_pressure_grad[2]};
+    const GpuArray<Real,AMREX_SPACEDIM> l_abl_geo_forcing{solverChoice.abl_geo_forcing[0],
+                                                          solverChoice.abl_geo_forcing[1],
+                                                          solverChoice.abl_geo_forcing[2]};
+
+    // Cells and all three face types of the tile
+    const Box nbx = amrex::surroundingNodes(bx);
+
+    ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        // ******************************************************************
+        // (rho) and (rho theta)
+        // ******************************************************************
+        if (bx.contains(IntVect(i,j,k)))
+        {
+            Real xflux_lo = rho_u(i  ,j,k) / mf_u(i  ,j  ,0);
+            Real xflux_hi = rho_u(i+1,j,k) / mf_u(i+1,j  ,0);
+            Real yflux_lo = rho_v(i,j  ,k) / mf_v(i  ,j  ,0);
+            Real yflux_hi = rho_v(i,j+1,k) / mf_v(i  ,j+1,0);
+            Real zflux_lo = rho_w(i,j,k  );
+            Real zflux_hi = rho_w(i,j,k+1);
+
+            avg_xmom(i  ,j,k) += fac*xflux_lo;
+            if (i == vbx_hi.x)
+                avg_xmom(i+1,j,k) += fac*xflux_hi;
+            avg_ymom(i,j  ,k) += fac*yflux_lo;
+            if (j == vbx_hi.y)
+                avg_ymom(i,j+1,k) += fac*yflux_hi;
+            avg_zmom(i,j,k  ) += fac*zflux_lo;
+            if (k == vbx_hi.z)
+               avg_zmom(i,j,k+1) += fac*zflux_hi;
+
+            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+            cell_rhs(i,j,k,Rho_comp) = -(
+                ( xflux_hi - xflux_lo ) * dxInv * mfsq +
+                ( yflux_hi - yflux_lo ) * dyInv * mfsq +
+                ( zflux_hi - zflux_lo ) * dzInv);
+
+            const int prim_index = 0;
+            Real rhs_theta = - 0.5 * (
+              ( xflux_hi * (cell_prim(i+1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) -
+                xflux_lo * (cell_prim(i-1,j,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dxInv * mfsq +
+              ( yflux_hi * (cell_prim(i,j+1,k,prim_index) + cell_prim(i,j,k,prim_index)) -
+                yflux_lo * (cell_prim(i,j-1,k,prim_index) + cell_prim(i,j,k,prim_index)) ) * dyInv * mfsq +
+              ( zflux_hi * (cell_prim(i,j,k+1,prim_index) + cell_prim(i,j,k,prim_index)) -
+                zflux_lo * (cell_prim(i,j,k-1,prim_index) + cell_prim(i,j,k,prim_index)) ) * dzInv);
+
+            rhs_theta += src_arr(i,j,k,RhoTheta_comp);
+
+            if (l_rayleigh_T) {
+                Real theta = cell_prim(i,j,k,PrimTheta_comp);
+                rhs_theta -= dptr_rayleigh_tau[k] * (theta - dptr_rayleigh_thetabar[k]) * cell_data(i,j,k,Rho_comp);
+            }
+
+            cell_rhs(i,j,k,RhoTheta_comp) = rhs_theta;
+        }
+
+        // ******************************************************************
+        // x-momentum
+        // ******************************************************************
+        if (tbx.contains(IntVect(i,j,k)))
+        {
+            Real mf_u_inv_hi = 1. / mf_u(i+1,j  ,0); Real mf_u_inv_mid = 1. / mf_u(i  ,j  ,0);
+            Real mf_u_inv_lo = 1. / mf_u(i-1,j  ,0);
+            Real mf_v_inv_1  = 1. / mf_v(i  ,j+1,0); Real mf_v_inv_2   = 1. / mf_v(i-1,j+1,0);
+            Real mf_v_inv_3  = 1. / mf_v(i  ,j  ,0); Real mf_v_inv_4 = 1. / mf_v(i-1,j  ,0);
+
+            Real xflux_hi = 0.25 * (rho_u(i, j  , k) * mf_u_inv_mid + rho_u(i+1, j  , k) * mf_u_inv_hi) * (u(i+1,j,k) + u(i,j,k));
+            Real xflux_lo = 0.25 * (rho_u(i, j  , k) * mf_u_inv_mid + rho_u(i-1, j  , k) * mf_u_inv_lo) * (u(i-1,j,k) + u(i,j,k));
+
+            Real yflux_hi = 0.25 * (rho_v(i, j+1, k) * mf_v_inv_1 + rho_v(i-1, j+1, k) * mf_v_inv_2) * (u(i,j+1,k) + u(i,j,k));
+            Real yflux_lo = 0.25 * (rho_v(i, j  , k) * mf_v_inv_3 + rho_v(i-1, j  , k) * mf_v_inv_4) * (u(i,j-1,k) + u(i,j,k));
+
+            Real zflux_hi = 0.25 * (rho_w(i, j, k+1) + rho_w(i-1, j, k+1)) * (u(i,j,k+1) + u(i,j,k));
+            Real zflux_lo = 0.25 * (rho_w(i, j, k  ) + rho_w(i-1, j, k  )) * (u(i,j,k-1) + u(i,j,k));
+
+            Real mfsq = mf_u(i,j,0) * mf_u(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+            Real rhs = -advectionSrc;
+
+            Real gpx = dxInv * (pp_arr(i,j,k) - pp_arr(i-1,j,k));
+            gpx *= mf_u(i,j,0);
+
+            Real q = 0.0;
+#if defined(ERF_USE_MOISTURE)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i-1,j,k,PrimQt_comp)
+                       +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i-1,j,k,PrimQp_comp) );
+#elif defined(ERF_USE_WARM_NO_PRECIP)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQv_comp) + cell_prim(i-1,j,k,PrimQv_comp)
+                       +cell_prim(i,j,k,PrimQc_comp) + cell_prim(i-1,j,k,PrimQc_comp) );
+#endif
+            rhs += -gpx / (1.0 + q)
+                 - l_abl_pressure_grad[0]
+                 + 0.5*(cell_data(i,j,k,Rho_comp)+cell_data(i-1,j,k,Rho_comp)) * l_abl_geo_forcing[0];
+
+            // Add Coriolis forcing (that assumes east is +x, north is +y)
+            if (l_use_coriolis)
+            {
+                Real rho_v_loc = 0.25 * (rho_v(i,j+1,k) + rho_v(i,j,k) + rho_v(i-1,j+1,k) + rho_v(i-1,j,k));
+                Real rho_w_loc = 0.25 * (rho_w(i,j,k+1) + rho_w(i,j,k) + rho_w(i,j-1,k+1) + rho_w(i,j-1,k));
+                rhs += l_coriolis_factor * (rho_v_loc * l_sinphi - rho_w_loc * l_cosphi);
+            }
+
+            // Add Rayleigh damping
+            if (l_rayleigh_U)
+            {
+                Real uu = rho_u(i,j,k) / cell_data(i,j,k,Rho_comp);
+                rhs -= dptr_rayleigh_tau[k] * (uu - dptr_rayleigh_ubar[k]) * cell_data(i,j,k,Rho_comp);
+            }
+
+            rho_u_rhs(i,j,k) = rhs;
+        }
+
+        // ******************************************************************
+        // y-momentum
+        // ******************************************************************
+        if (tby.contains(IntVect(i,j,k)))
+        {
+            Real mf_v_inv_hi = 1. / mf_v(i  ,j+1,0); Real mf_v_inv_mid = 1. / mf_v(i  ,j  ,0);
+            Real mf_v_inv_lo = 1. / mf_v(i  ,j-1,0);
+            Real mf_u_inv_1  = 1. / mf_u(i+1,j  ,0); Real mf_u_inv_2   = 1. / mf_u(i+1,j-1,0);
+            Real mf_u_inv_3  = 1. / mf_u(i  ,j  ,0); Real mf_u_inv_4 = 1. / mf_u(i  ,j-1,0);
+
+            Real xflux_hi = 0.25 * (rho_u(i+1, j, k) * mf_u_inv_1 + rho_u(i+1, j-1, k) * mf_u_inv_2) * (v(i+1,j,k) + v(i,j,k));
+            Real xflux_lo = 0.25 * (rho_u(i  , j, k) * mf_u_inv_3 + rho_u(i  , j-1, k) * mf_u_inv_4) * (v(i-1,j,k) + v(i,j,k));
+
+            Real yflux_hi = 0.25 * (rho_v(i  ,j+1,k) * mf_v_inv_hi  + rho_v(i  ,j  ,k) * mf_v_inv_mid) * (v(i,j+1,k) + v(i,j,k));
+            Real yflux_lo = 0.25 * (rho_v(i  ,j  ,k) * mf_v_inv_mid + rho_v(i  ,j-1,k) * mf_v_inv_lo ) * (v(i,j-1,k) + v(i,j,k));
+
+            Real zflux_hi = 0.25 * (rho_w(i, j, k+1) + rho_w(i, j-1, k+1)) * (v(i,j,k+1) + v(i,j,k));
+            Real zflux_lo = 0.25 * (rho_w(i, j, k  ) + rho_w(i, j-1, k  )) * (v(i,j,k-1) + v(i,j,k));
+
+            Real mfsq = mf_v(i,j,0) * mf_v(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+            Real rhs = -advectionSrc;
+
+            Real gpy = dyInv * (pp_arr(i,j,k) - pp_arr(i,j-1,k));
+            gpy *= mf_v(i,j,0);
+
+            Real q = 0.0;
+#if defined(ERF_USE_MOISTURE)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i,j-1,k,PrimQt_comp)
+                       +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i,j-1,k,PrimQp_comp) );
+#elif defined(ERF_USE_WARM_NO_PRECIP)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQv_comp) + cell_prim(i,j-1,k,PrimQv_comp)
+                       +cell_prim(i,j,k,PrimQc_comp) + cell_prim(i,j-1,k,PrimQc_comp) );
+#endif
+            rhs += -gpy / (1.0_rt + q)
+                 - l_abl_pressure_grad[1]
+                 + 0.5*(cell_data(i,j,k,Rho_comp)+cell_data(i,j-1,k,Rho_comp)) * l_abl_geo_forcing[1];
+
+            // Add Coriolis forcing (that assumes east is +x, north is +y)
+            if (l_use_coriolis)
+            {
+                Real rho_u_loc = 0.25 * (rho_u(i+1,j,k) + rho_u(i,j,k) + rho_u(i+1,j-1,k) + rho_u(i,j-1,k));
+                rhs += -l_coriolis_factor * rho_u_loc * l_sinphi;
+            }
+
+            // Add Rayleigh damping
+            if (l_rayleigh_V)
+            {
+                Real vv = rho_v(i,j,k) / cell_data(i,j,k,Rho_comp);
+                rhs -= dptr_rayleigh_tau[k] * (vv - dptr_rayleigh_vbar[k]) * cell_data(i,j,k,Rho_comp);
+            }
+
+            rho_v_rhs(i,j,k) = rhs;
+        }
+
+        // ******************************************************************
+        // z-momentum
+        // ******************************************************************
+        if (tbz.contains(IntVect(i,j,k)))
+        {
+            Real mf_u_inv_hi = 1. / mf_u(i+1,j  ,0); Real mf_u_inv_lo = 1. / mf_u(i  ,j  ,0);
+            Real mf_v_inv_hi = 1. / mf_v(i  ,j+1,0); Real mf_v_inv_lo = 1. / mf_v(i  ,j  ,0);
+
+            Real xflux_hi = 0.25*(rho_u(i+1,j  ,k) + rho_u(i+1, j, k-1)) * mf_u_inv_hi * (w(i+1,j,k) + w(i,j,k));
+            Real xflux_lo = 0.25*(rho_u(i  ,j  ,k) + rho_u(i  , j, k-1)) * mf_u_inv_lo * (w(i-1,j,k) + w(i,j,k));
+
+            Real yflux_hi = 0.25*(rho_v(i  ,j+1,k) + rho_v(i, j+1, k-1)) * mf_v_inv_hi * (w(i,j+1,k) + w(i,j,k));
+            Real yflux_lo = 0.25*(rho_v(i  ,j  ,k) + rho_v(i, j  , k-1)) * mf_v_inv_lo * (w(i,j-1,k) + w(i,j,k));
+
+            Real zflux_lo = 0.25 * (rho_w(i,j,k) + rho_w(i,j,k-1)) * (w(i,j,k) + w(i,j,k-1));
+
+            Real zflux_hi = (k == domhi_z+1) ? rho_w(i,j,k) * w(i,j,k) :
+                                               0.25 * (rho_w(i,j,k) + rho_w(i,j,k+1)) * (w(i,j,k) + w(i,j,k+1));
+
+            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+            Real rhs = -advectionSrc;
+
+            Real gpz = dzInv * ( pp_arr(i,j,k)-pp_arr(i,j,k-1) );
+
+            Real q = 0.0;
+#if defined(ERF_USE_MOISTURE)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i,j,k-1,PrimQt_comp)
+                       +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i,j,k-1,PrimQp_comp) );
+#elif defined(ERF_USE_WARM_NO_PRECIP)
+            q = 0.5 * ( cell_prim(i,j,k,PrimQv_comp) + cell_prim(i,j,k-1,PrimQv_comp)
+                       +cell_prim(i,j,k,PrimQc_comp) + cell_prim(i,j,k-1,PrimQc_comp) );
+#endif
+            rhs += (buoyancy_fab(i,j,k) - gpz) / (1.0_rt + q)
+                 - l_abl_pressure_grad[2]
+                 + 0.5*(cell_data(i,j,k,Rho_comp)+cell_data(i,j,k-1,Rho_comp)) * l_abl_geo_forcing[2];
+
+            // Add Coriolis forcing (that assumes east is +x, north is +y)
+            if (l_use_coriolis)
+            {
+                Real rho_u_loc = 0.25 * (rho_u(i+1,j,k) + rho_u(i,j,k) + rho_u(i+1,j,k-1) + rho_u(i,j,k-1));
+                rhs += l_coriolis_factor * rho_u_loc * l_cosphi;
+            }
+
+            // Add Rayleigh damping
+            if (l_rayleigh_W)
+            {
+                Real ww = rho_w(i,j,k) / cell_data(i,j,k,Rho_comp);
+                rhs -= dptr_rayleigh_tau[k] * (ww - dptr_rayleigh_wbar[k]) * cell_data(i,j,k,Rho_comp);
+            }
+
+            rho_w_rhs(i,j,k) = rhs;
+        }
+
+        // Enforce no forcing term at top and bottom boundaries
+        if (k == 0 && b2d.contains(IntVect(i,j,0))) {
+            rho_w_rhs(i,j,        0) = 0.;
+            rho_w_rhs(i,j,domhi_z+1) = 0.;
+        }
+    });
+}
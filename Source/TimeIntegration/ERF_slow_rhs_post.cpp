@@ -24,9 +24,9 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
                         const MultiFab& yvel,
                         const MultiFab& zvel,
                         const MultiFab& source,
-                        const MultiFab* SmnSmn,
+                        const AuxMultiFab* SmnSmn,
                         const MultiFab* eddyDiffs,
-                        MultiFab* Hfx3, MultiFab* Diss,
+                        AuxMultiFab* Hfx3, AuxMultiFab* Diss,
                         const amrex::Geometry geom,
                         const SolverChoice& solverChoice,
                         std::unique_ptr<ABLMost>& most,
@@ -61,6 +61,7 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
     const bool l_all_WENO       = solverChoice.all_use_WENO;
     const bool l_moist_WENO     = solverChoice.moist_use_WENO;
     const int  l_spatial_order_WENO = solverChoice.spatial_order_WENO;
+    const int  l_scalar_comp_block  = solverChoice.scalar_comp_block;
 
     const amrex::BCRec* bc_ptr = domain_bcs_type_d.data();
 
@@ -149,7 +150,7 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
         const Array4<const Real>& mf_v = mapfac_v->const_array(mfi);
 
         // SmnSmn for KE src with Deardorff
-        const Array4<const Real>& SmnSmn_a = l_use_deardorff ? SmnSmn->const_array(mfi) : Array4<const Real>{};
+        const Array4<const AuxReal>& SmnSmn_a = l_use_deardorff ? SmnSmn->const_array(mfi) : Array4<const AuxReal>{};
 
         // **************************************************************************
         // Here we fill the "current" data with "new" data because that is the result of the previous RK stage
@@ -170,38 +171,39 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
         // **************************************************************************
         // Define updates in the RHS of continuity, temperature, and scalar equations
         // **************************************************************************
+        //
+        // The scalars are advected together so the face fluxes are only read once per cell;
+        // RhoKE can only be included in the same call if RhoQKE (which sits between it and
+        // RhoScalar) is also advected
         int start_comp;
         int   num_comp;
-        if (l_use_deardorff) {
+        if (l_use_deardorff && !l_use_QKE) {
             start_comp = RhoKE_comp;
               num_comp = 1;
             AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
                                    cur_prim, cell_rhs, detJ,
                                    dxInv, mf_m, l_all_WENO, l_moist_WENO, l_spatial_order_WENO,
-                                   l_horiz_spatial_order, l_vert_spatial_order, l_use_terrain);
+                                   l_horiz_spatial_order, l_vert_spatial_order, l_use_terrain,
+                                   l_scalar_comp_block);
         }
+        start_comp = RhoScalar_comp;
         if (l_use_QKE) {
-            start_comp = RhoQKE_comp;
-              num_comp = 1;
-            AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
-                                   cur_prim, cell_rhs, detJ,
-                                   dxInv, mf_m, l_all_WENO, l_moist_WENO, l_spatial_order_WENO,
-                                   l_horiz_spatial_order, l_vert_spatial_order, l_use_terrain);
+            start_comp = (l_use_deardorff) ? RhoKE_comp : RhoQKE_comp;
         }
-        start_comp = RhoScalar_comp;
           num_comp = S_data[IntVar::cons].nComp() - start_comp;
         AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
                                cur_prim, cell_rhs, detJ,
                                dxInv, mf_m, l_all_WENO, l_moist_WENO, l_spatial_order_WENO,
-                               l_horiz_spatial_order, l_vert_spatial_order, l_use_terrain);
+                               l_horiz_spatial_order, l_vert_spatial_order, l_use_terrain,
+                               l_scalar_comp_block);
 
         if (l_use_diff) {
             Array4<Real> diffflux_x = dflux_x->array(mfi);
             Array4<Real> diffflux_y = dflux_y->array(mfi);
             Array4<Real> diffflux_z = dflux_z->array(mfi);
 
-            Array4<Real> hfx_z = Hfx3->array(mfi);
-            Array4<Real> diss  = Diss->array(mfi);
+            Array4<AuxReal> hfx_z = Hfx3->array(mfi);
+            Array4<AuxReal> diss  = Diss->array(mfi);
 
             const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
 
@@ -34,12 +34,12 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                        MultiFab& Omega,
                        const MultiFab& source,
                        const MultiFab& buoyancy,
-                       MultiFab* Tau11, MultiFab* Tau22, MultiFab* Tau33,
-                       MultiFab* Tau12, MultiFab* Tau13, MultiFab* Tau21,
-                       MultiFab* Tau23, MultiFab* Tau31, MultiFab* Tau32,
-                       MultiFab* SmnSmn,
+                       AuxMultiFab* Tau11, AuxMultiFab* Tau22, AuxMultiFab* Tau33,
+                       AuxMultiFab* Tau12, AuxMultiFab* Tau13, AuxMultiFab* Tau21,
+                       AuxMultiFab* Tau23, AuxMultiFab* Tau31, AuxMultiFab* Tau32,
+                       AuxMultiFab* SmnSmn,
                        MultiFab* eddyDiffs,
-                       MultiFab* Hfx3, MultiFab* Diss,
+                       AuxMultiFab* Hfx3, AuxMultiFab* Diss,
                        const amrex::Geometry geom,
                        const SolverChoice& solverChoice,
                        std::unique_ptr<ABLMost>& most,
@@ -80,6 +80,7 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                                     solverChoice.pbl_type == PBLType::MYNN25 );
     const bool l_all_WENO       = solverChoice.all_use_WENO;
     const int  l_spatial_order_WENO = solverChoice.spatial_order_WENO;
+    const bool l_fused_rhs      = solverChoice.use_fused_slow_rhs;
 
     const amrex::BCRec* bc_ptr   = domain_bcs_type_d.data();
     const amrex::BCRec* bc_ptr_h = domain_bcs_type.data();
@@ -124,14 +125,96 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         dflux_y = new MultiFab(convert(ba,IntVect(0,1,0)), dm, nvars, 0);
         dflux_z = new MultiFab(convert(ba,IntVect(0,0,1)), dm, nvars, 0);
 
+        //-------------------------------------------------------------------------------
+        // NOTE: The Tau MultiFabs are the strain/stress workspace. The strain is computed
+        //       here from the stage velocities at every RK stage. The strain computed at the
+        //       start of the step for the turbulence models cannot be reused in the first
+        //       stage: the eddy viscosity made from it is what the MOST boundary fill of the
+        //       first stage uses, so the ghost cells of the stage velocities are only known
+        //       after it. The strain is then turned into stress in place in Tau.
+        //
+        //       Strain is computed over each grown box rather than each tile, so the
+        //       one-sided stencils at Dirichlet boundaries only land on box edges and the
+        //       halo cells are never written by more than one tile.
+        //-------------------------------------------------------------------------------
+        {
+        BL_PROFILE("slow_rhs_making_strain");
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(S_data[IntVar::cons],false); mfi.isValid(); ++mfi)
+        {
+            Box bxcc  = mfi.growntilebox(IntVect(1,1,0));
+            Box tbxxy = mfi.tilebox(IntVect(1,1,0),IntVect(1,1,0));
+            Box tbxxz = mfi.tilebox(IntVect(1,0,1),IntVect(1,1,0));
+            Box tbxyz = mfi.tilebox(IntVect(0,1,1),IntVect(1,1,0));
+
+            const Array4<const Real> & u = xvel.array(mfi);
+            const Array4<const Real> & v = yvel.array(mfi);
+            const Array4<const Real> & w = zvel.array(mfi);
+
+            Array4<AuxReal> tau11 = Tau11->array(mfi); Array4<AuxReal> tau22 = Tau22->array(mfi); Array4<AuxReal> tau33 = Tau33->array(mfi);
+            Array4<AuxReal> tau12 = Tau12->array(mfi); Array4<AuxReal> tau13 = Tau13->array(mfi); Array4<AuxReal> tau23 = Tau23->array(mfi);
+
+            const Array4<const Real>& mf_m = mapfac_m->const_array(mfi);
+            const Array4<const Real>& mf_u = mapfac_u->const_array(mfi);
+            const Array4<const Real>& mf_v = mapfac_v->const_array(mfi);
+
+            if (l_use_terrain) {
+                Array4<AuxReal> tau21 = Tau21->array(mfi); Array4<AuxReal> tau31 = Tau31->array(mfi); Array4<AuxReal> tau32 = Tau32->array(mfi);
+                const Array4<const Real>& z_nd = z_phys_nd->const_array(mfi);
+                ComputeStrain_T(bxcc, tbxxy, tbxxz, tbxyz,
+                                u, v, w,
+                                tau11, tau22, tau33,
+                                tau12, tau13,
+                                tau21, tau23,
+                                tau31, tau32,
+                                z_nd, bc_ptr_h, dxInv,
+                                mf_m, mf_u, mf_v);
+            } else {
+                ComputeStrain_N(bxcc, tbxxy, tbxxz, tbxyz,
+                                u, v, w,
+                                tau11, tau22, tau33,
+                                tau12, tau13, tau23,
+                                bc_ptr_h, dxInv,
+                                mf_m, mf_u, mf_v);
+            }
+        } // MFIter
+        } // making strain
+
+        // Populate SmnSmn if using Deardorff (used as diff src in post)
+        // and in the first RK stage (TKE tendencies constant for nrk>0, following WRF).
+        // This reads the strain on the edges around each cell so it must be done
+        // before any tile turns its part of Tau into stress.
+        if ((nrk==0) && (solverChoice.les_type == LESType::Deardorff)) {
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for ( MFIter mfi(S_data[IntVar::cons],TileNoZ()); mfi.isValid(); ++mfi)
+            {
+                Box bx = mfi.tilebox() & grids_to_evolve[mfi.index()];
+
+                const Array4<const AuxReal>& tau11 = Tau11->const_array(mfi);
+                const Array4<const AuxReal>& tau22 = Tau22->const_array(mfi);
+                const Array4<const AuxReal>& tau33 = Tau33->const_array(mfi);
+                const Array4<const AuxReal>& tau12 = Tau12->const_array(mfi);
+                const Array4<const AuxReal>& tau13 = Tau13->const_array(mfi);
+                const Array4<const AuxReal>& tau23 = Tau23->const_array(mfi);
+
+                const Array4<AuxReal>& SmnSmn_a = SmnSmn->array(mfi);
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    SmnSmn_a(i,j,k) = ComputeSmnSmn(i,j,k,tau11,tau22,tau33,tau12,tau13,tau23);
+                });
+            }
+        }
+
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(S_data[IntVar::cons],TileNoZ()); mfi.isValid(); ++mfi)
         {
-            // Construct intersection of current tilebox and valid region for updating
             const Box& valid_bx = grids_to_evolve[mfi.index()];
-            Box bx = mfi.tilebox() & valid_bx;
 
             // Velocities
             const Array4<const Real> & u = xvel.array(mfi);
@@ -153,66 +236,25 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
             const Array4<const Real>& z_nd   = l_use_terrain ? z_phys_nd->const_array(mfi) : Array4<const Real>{};
             const Array4<const Real>& detJ   = l_use_terrain ?        dJ->const_array(mfi) : Array4<const Real>{};
 
-            //-------------------------------------------------------------------------------
-            // NOTE: Tile boxes with terrain are not intuitive. The linear combination of
-            //       stress terms requires care. Create a tile box that intersects the
-            //       valid box, then grow the box in x/y. Compute the strain on the local
-            //       FAB over this grown tile box. Compute the stress over the tile box,
-            //       except tau_ii which still needs the halo cells. Finally, write from
-            //       the local FAB to the Tau MF but only on the tile box.
-            //-------------------------------------------------------------------------------
-
-            //-------------------------------------------------------------------------------
-            // TODO: Avoid recomputing strain on the first RK stage. One could populate
-            //       the FABs with tau_ij, compute stress, and then write to tau_ij. The
-            //       problem with this approach is you will over-write the needed halo layer
-            //       needed by subsequent tile boxes (particularly S_ii becomes Tau_ii).
-            //-------------------------------------------------------------------------------
-
-            // Strain/Stress tile boxes
+            // The expansion rate and tau_ii are needed in one halo cell around the valid
+            // region; the grown tile boxes tile that region without overlap
             Box vbx   = valid_bx;
-            Box bxcc  = mfi.tilebox() & valid_bx;
+            Box bxcc  = mfi.growntilebox(IntVect(1,1,0)) & amrex::grow(vbx,IntVect(1,1,0));
             Box tbxxy = mfi.tilebox(IntVect(1,1,0)) & vbx.convert(IntVect(1,1,0));
             Box tbxxz = mfi.tilebox(IntVect(1,0,1)) & vbx.convert(IntVect(1,0,1));
             Box tbxyz = mfi.tilebox(IntVect(0,1,1)) & vbx.convert(IntVect(0,1,1));
-            // We need a halo cells for terrain
-             bxcc.grow(IntVect(1,1,0));
-            tbxxy.grow(IntVect(1,1,0));
-            tbxxz.grow(IntVect(1,1,0));
-            tbxyz.grow(IntVect(1,1,0));
 
             // Expansion rate
             Array4<Real> er_arr = expr->array(mfi);
 
-            // Temporary storage for tiling/OMP
-            FArrayBox S11,S22,S33;
-            FArrayBox S12,S13,S23;
-            S11.resize(bxcc,1);  S22.resize(bxcc,1);  S33.resize(bxcc,1);
-            S12.resize(tbxxy,1); S13.resize(tbxxz,1); S23.resize(tbxyz,1);
-            Elixir S11_eli   = S11.elixir(); Elixir S22_eli   = S22.elixir(); Elixir S33_eli   = S33.elixir();
-            Elixir S12_eli   = S12.elixir(); Elixir S13_eli   = S13.elixir(); Elixir S23_eli   = S23.elixir();
-            Array4<Real> s11 = S11.array();  Array4<Real> s22 = S22.array();  Array4<Real> s33 = S33.array();
-            Array4<Real> s12 = S12.array();  Array4<Real> s13 = S13.array();  Array4<Real> s23 = S23.array();
-
             // Symmetric strain/stresses
-            Array4<Real> tau11 = Tau11->array(mfi); Array4<Real> tau22 = Tau22->array(mfi); Array4<Real> tau33 = Tau33->array(mfi);
-            Array4<Real> tau12 = Tau12->array(mfi); Array4<Real> tau13 = Tau13->array(mfi); Array4<Real> tau23 = Tau23->array(mfi);
-
-            // Strain magnitude
-            Array4<Real> SmnSmn_a;
+            Array4<AuxReal> tau11 = Tau11->array(mfi); Array4<AuxReal> tau22 = Tau22->array(mfi); Array4<AuxReal> tau33 = Tau33->array(mfi);
+            Array4<AuxReal> tau12 = Tau12->array(mfi); Array4<AuxReal> tau13 = Tau13->array(mfi); Array4<AuxReal> tau23 = Tau23->array(mfi);
 
             if (l_use_terrain) {
-                // Terrain non-symmetric terms
-                FArrayBox S21,S31,S32;
-                S21.resize(tbxxy,1); S31.resize(tbxxz,1); S32.resize(tbxyz,1);
-                Elixir S21_eli     = S21.elixir();      Elixir S31_eli     = S31.elixir();      Elixir S32_eli     = S32.elixir();
-                Array4<Real> s21   = S21.array();       Array4<Real> s31   = S31.array();       Array4<Real> s32   = S32.array();
-                Array4<Real> tau21 = Tau21->array(mfi); Array4<Real> tau31 = Tau31->array(mfi); Array4<Real> tau32 = Tau32->array(mfi);
-
                 //-----------------------------------------
                 // Expansion rate compute terrain
                 //-----------------------------------------
-                {
                 BL_PROFILE("slow_rhs_making_er_T");
                 // First create Omega using velocity (not momentum)
                 Box gbxo = surroundingNodes(bxcc,2);
@@ -241,98 +283,10 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
 
                     er_arr(i,j,k) = expansionRate / detJ(i,j,k);
                 });
-                } // end profile
-
-                //-----------------------------------------
-                // Strain tensor compute terrain
-                //-----------------------------------------
-                {
-                BL_PROFILE("slow_rhs_making_strain_T");
-                ComputeStrain_T(bxcc, tbxxy, tbxxz, tbxyz,
-                                u, v, w,
-                                s11, s22, s33,
-                                s12, s13,
-                                s21, s23,
-                                s31, s32,
-                                z_nd, bc_ptr_h, dxInv,
-                                mf_m, mf_u, mf_v);
-                } // profile
-
-                // Populate SmnSmn if using Deardorff (used as diff src in post)
-                // and in the first RK stage (TKE tendencies constant for nrk>0, following WRF)
-                if ((nrk==0) && (solverChoice.les_type == LESType::Deardorff)) {
-                    SmnSmn_a = SmnSmn->array(mfi);
-                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                    {
-                        SmnSmn_a(i,j,k) = ComputeSmnSmn(i,j,k,s11,s22,s33,s12,s13,s23);
-                    });
-                }
-
-                //-----------------------------------------
-                // Stress tensor compute terrain
-                //-----------------------------------------
-                {
-                BL_PROFILE("slow_rhs_making_stress_T");
-
-                // Remove Halo cells just for tau_ij comps
-                tbxxy.grow(IntVect(-1,-1,0));
-                tbxxz.grow(IntVect(-1,-1,0));
-                tbxyz.grow(IntVect(-1,-1,0));
-
-                Real mu_eff = 0.;
-                if (cons_visc) {
-                    mu_eff += 2.0 * solverChoice.dynamicViscosity;
-                    ComputeStressConsVisc_T(bxcc, tbxxy, tbxxz, tbxyz, mu_eff,
-                                            s11, s22, s33,
-                                            s12, s13,
-                                            s21, s23,
-                                            s31, s32,
-                                            er_arr, z_nd, dxInv);
-                } else {
-                    ComputeStressVarVisc_T(bxcc, tbxxy, tbxxz, tbxyz, mu_eff, mu_turb,
-                                           s11, s22, s33,
-                                           s12, s13,
-                                           s21, s23,
-                                           s31, s32,
-                                           er_arr, z_nd, dxInv);
-                }
-
-                // Remove halo cells from tau_ii but extend across valid_box bdry
-                bxcc.grow(IntVect(-1,-1,0));
-                if (bxcc.smallEnd(0) == valid_bx.smallEnd(0)) bxcc.growLo(0, 1);
-                if (bxcc.bigEnd(0)   == valid_bx.bigEnd(0))   bxcc.growHi(0, 1);
-                if (bxcc.smallEnd(1) == valid_bx.smallEnd(1)) bxcc.growLo(1, 1);
-                if (bxcc.bigEnd(1)   == valid_bx.bigEnd(1))   bxcc.growHi(1, 1);
-
-                // Copy from temp FABs back to tau
-                amrex::ParallelFor(bxcc,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau11(i,j,k) = s11(i,j,k);
-                    tau22(i,j,k) = s22(i,j,k);
-                    tau33(i,j,k) = s33(i,j,k);
-                });
-
-                amrex::ParallelFor(tbxxy, tbxxz, tbxyz,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau12(i,j,k) = s12(i,j,k);
-                    tau21(i,j,k) = s21(i,j,k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau13(i,j,k) = s13(i,j,k);
-                    tau31(i,j,k) = s31(i,j,k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau23(i,j,k) = s23(i,j,k);
-                    tau32(i,j,k) = s32(i,j,k);
-                });
-                } // end profile
-
             } else {
-
                 //-----------------------------------------
                 // Expansion rate compute no terrain
                 //-----------------------------------------
-                {
                 BL_PROFILE("slow_rhs_making_er_N");
                 amrex::ParallelFor(bxcc, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
                     Real mfsq = mf_m(i,j,0)*mf_m(i,j,0);
@@ -340,84 +294,77 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                                     (v(i  , j+1, k  )/mf_v(i,j+1,0) - v(i, j, k)/mf_v(i,j,0))*dxInv[1]*mfsq +
                                     (w(i  , j  , k+1) - w(i, j, k))*dxInv[2];
                 });
-                } // end profile
-
-
-                //-----------------------------------------
-                // Strain tensor compute no terrain
-                //-----------------------------------------
-                {
-                BL_PROFILE("slow_rhs_making_strain_N");
-                ComputeStrain_N(bxcc, tbxxy, tbxxz, tbxyz,
-                                u, v, w,
-                                s11, s22, s33,
-                                s12, s13, s23,
-                                bc_ptr_h, dxInv,
-                                mf_m, mf_u, mf_v);
-                } // end profile
-
-                // Populate SmnSmn if using Deardorff (used as diff src in post)
-                // and in the first RK stage (TKE tendencies constant for nrk>0, following WRF)
-                if ((nrk==0) && (solverChoice.les_type == LESType::Deardorff)) {
-                    SmnSmn_a = SmnSmn->array(mfi);
-                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                    {
-                        SmnSmn_a(i,j,k) = ComputeSmnSmn(i,j,k,s11,s22,s33,s12,s13,s23);
-                    });
-                }
+            } // l_use_terrain
 
-                //-----------------------------------------
-                // Stress tensor compute no terrain
-                //-----------------------------------------
-                {
+            //-----------------------------------------
+            // Stress tensor compute no terrain
+            //-----------------------------------------
+            // Without terrain the stress at a point only needs the strain at that
+            // point, so each tile can turn its own part of Tau into stress
+            if (!l_use_terrain) {
                 BL_PROFILE("slow_rhs_making_stress_N");
-
-                // Remove Halo cells just for tau_ij comps
-                tbxxy.grow(IntVect(-1,-1,0));
-                tbxxz.grow(IntVect(-1,-1,0));
-                tbxyz.grow(IntVect(-1,-1,0));
-
                 Real mu_eff = 0.;
                 if (cons_visc) {
                     mu_eff += 2.0 * solverChoice.dynamicViscosity;
                     ComputeStressConsVisc_N(bxcc, tbxxy, tbxxz, tbxyz, mu_eff,
-                                            s11, s22, s33,
-                                            s12, s13, s23,
+                                            tau11, tau22, tau33,
+                                            tau12, tau13, tau23,
                                             er_arr);
                 } else {
                     ComputeStressVarVisc_N(bxcc, tbxxy, tbxxz, tbxyz, mu_eff, mu_turb,
-                                           s11, s22, s33,
-                                           s12, s13, s23,
+                                           tau11, tau22, tau33,
+                                           tau12, tau13, tau23,
                                            er_arr);
                 }
-
-                // Remove halo cells from tau_ii but extend across valid_box bdry
-                bxcc.grow(IntVect(-1,-1,0));
-                if (bxcc.smallEnd(0) == valid_bx.smallEnd(0)) bxcc.growLo(0, 1);
-                if (bxcc.bigEnd(0)   == valid_bx.bigEnd(0))   bxcc.growHi(0, 1);
-                if (bxcc.smallEnd(1) == valid_bx.smallEnd(1)) bxcc.growLo(1, 1);
-                if (bxcc.bigEnd(1)   == valid_bx.bigEnd(1))   bxcc.growHi(1, 1);
-
-                // Copy from temp FABs back to tau
-                amrex::ParallelFor(bxcc,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau11(i,j,k) = s11(i,j,k);
-                    tau22(i,j,k) = s22(i,j,k);
-                    tau33(i,j,k) = s33(i,j,k);
-                });
-                amrex::ParallelFor(tbxxy, tbxxz, tbxyz,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau12(i,j,k) = s12(i,j,k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau13(i,j,k) = s13(i,j,k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-                    tau23(i,j,k) = s23(i,j,k);
-                });
-                } // end profile
-            } // l_use_terrain
+            }
         } // MFIter
+
+        //-----------------------------------------
+        // Stress tensor compute terrain
+        //-----------------------------------------
+        // With terrain the stress is a linear combination of the strain at neighboring
+        // points, so we work box by box so that no other thread is modifying the strain
+        // we read
+        if (l_use_terrain) {
+            BL_PROFILE("slow_rhs_making_stress_T");
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for ( MFIter mfi(S_data[IntVar::cons],false); mfi.isValid(); ++mfi)
+            {
+                Box vbx   = grids_to_evolve[mfi.index()];
+                Box bxcc  = amrex::grow(vbx,IntVect(1,1,0));
+                Box tbxxy = convert(vbx,IntVect(1,1,0));
+                Box tbxxz = convert(vbx,IntVect(1,0,1));
+                Box tbxyz = convert(vbx,IntVect(0,1,1));
+
+                const Array4<const Real>& er_arr  = expr->const_array(mfi);
+                const Array4<Real const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const Real>{};
+                const Array4<const Real>& z_nd    = z_phys_nd->const_array(mfi);
+
+                Array4<AuxReal> tau11 = Tau11->array(mfi); Array4<AuxReal> tau22 = Tau22->array(mfi); Array4<AuxReal> tau33 = Tau33->array(mfi);
+                Array4<AuxReal> tau12 = Tau12->array(mfi); Array4<AuxReal> tau13 = Tau13->array(mfi); Array4<AuxReal> tau23 = Tau23->array(mfi);
+                Array4<AuxReal> tau21 = Tau21->array(mfi); Array4<AuxReal> tau31 = Tau31->array(mfi); Array4<AuxReal> tau32 = Tau32->array(mfi);
+
+                Real mu_eff = 0.;
+                if (cons_visc) {
+                    mu_eff += 2.0 * solverChoice.dynamicViscosity;
+                    ComputeStressConsVisc_T(bxcc, tbxxy, tbxxz, tbxyz, mu_eff,
+                                            tau11, tau22, tau33,
+                                            tau12, tau13,
+                                            tau21, tau23,
+                                            tau31, tau32,
+                                            er_arr, z_nd, dxInv);
+                } else {
+                    ComputeStressVarVisc_T(bxcc, tbxxy, tbxxz, tbxyz, mu_eff, mu_turb,
+                                           tau11, tau22, tau33,
+                                           tau12, tau13,
+                                           tau21, tau23,
+                                           tau31, tau32,
+                                           er_arr, z_nd, dxInv);
+                }
+            } // MFIter
+        } // l_use_terrain
     } // l_use_diff
 
 
@@ -555,7 +502,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                         omega_arr(i,j,k) = OmegaFromW(i,j,k,rho_w(i,j,k),rho_u,rho_v,z_nd,dxInv);
                     });
                 }
-            } else {
+            } else if (!l_fused_rhs) {
+                // (The fused path reads rho_w directly)
                 amrex::ParallelFor(gbxo, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
                     omega_arr(i,j,k) = rho_w(i,j,k);
                 });
@@ -575,29 +523,86 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         }
 
         // No terrain diffusion
-        Array4<Real> tau11,tau22,tau33;
-        Array4<Real> tau12,tau13,tau23;
+        Array4<AuxReal> tau11,tau22,tau33;
+        Array4<AuxReal> tau12,tau13,tau23;
         if (Tau11) {
             tau11 = Tau11->array(mfi); tau22 = Tau22->array(mfi); tau33 = Tau33->array(mfi);
             tau12 = Tau12->array(mfi); tau13 = Tau13->array(mfi); tau23 = Tau23->array(mfi);
         } else {
-            tau11 = Array4<Real>{}; tau22 = Array4<Real>{}; tau33 = Array4<Real>{};
-            tau12 = Array4<Real>{}; tau13 = Array4<Real>{}; tau23 = Array4<Real>{};
+            tau11 = Array4<AuxReal>{}; tau22 = Array4<AuxReal>{}; tau33 = Array4<AuxReal>{};
+            tau12 = Array4<AuxReal>{}; tau13 = Array4<AuxReal>{}; tau23 = Array4<AuxReal>{};
         }
         // Terrain diffusion
-        Array4<Real> tau21,tau31,tau32;
+        Array4<AuxReal> tau21,tau31,tau32;
         if (Tau21) {
             tau21 = Tau21->array(mfi); tau31 = Tau31->array(mfi); tau32 = Tau32->array(mfi);
         } else {
-            tau21 = Array4<Real>{}; tau31 = Array4<Real>{}; tau32 = Array4<Real>{};
+            tau21 = Array4<AuxReal>{}; tau31 = Array4<AuxReal>{}; tau32 = Array4<AuxReal>{};
         }
 
         // Strain magnitude
-        Array4<Real> SmnSmn_a;
+        Array4<AuxReal> SmnSmn_a;
         if (solverChoice.les_type == LESType::Deardorff) {
             SmnSmn_a = SmnSmn->array(mfi);
         } else {
-            SmnSmn_a = Array4<Real>{};
+            SmnSmn_a = Array4<AuxReal>{};
+        }
+
+        // **************************************************************************
+        // Fused path: advection, pressure gradient, buoyancy and forcing for all of
+        // S_rhs in one kernel; only the diffusive terms are added separately
+        // **************************************************************************
+        if (l_fused_rhs) {
+            erf_fused_slow_rhs_N(bx, valid_bx, tbx, tby, tbz,
+                                 cell_rhs, rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                 avg_xmom, avg_ymom, avg_zmom,
+                                 cell_data, cell_prim, u, v, w, rho_u, rho_v, rho_w,
+                                 pp_arr, buoyancy_fab, source.const_array(mfi),
+                                 mf_m, mf_u, mf_v, dxInv, solverChoice, domhi_z,
+                                 dptr_rayleigh_tau, dptr_rayleigh_ubar, dptr_rayleigh_vbar,
+                                 dptr_rayleigh_wbar, dptr_rayleigh_thetabar);
+
+            if (l_use_diff) {
+                Array4<Real> diffflux_x = dflux_x->array(mfi);
+                Array4<Real> diffflux_y = dflux_y->array(mfi);
+                Array4<Real> diffflux_z = dflux_z->array(mfi);
+
+                Array4<AuxReal> hfx_z = Hfx3->array(mfi);
+                Array4<AuxReal> diss  = Diss->array(mfi);
+
+                const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
+
+                // NOTE: No diffusion for continuity, so n starts at 1.
+                int n_start = amrex::max(start_comp,RhoTheta_comp);
+                int n_comp  = end_comp - n_start + 1;
+
+                DiffusionSrcForState_N(bx, domain, n_start, n_comp, u, v,
+                                       cell_data, cell_prim, cell_rhs,
+                                       diffflux_x, diffflux_y, diffflux_z,
+                                       dxInv, SmnSmn_a, mf_m, mf_u, mf_v,
+                                       hfx_z, diss,
+                                       mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+
+                DiffusionSrcForMom_N(tbx, tby, tbz,
+                                     rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                     tau11, tau22, tau33,
+                                     tau12, tau13, tau23,
+                                     cell_data, solverChoice, dxInv,
+                                     mf_m, mf_u, mf_v);
+            }
+
+            if (l_use_ndiff) {
+                NumericalDiffusion(bx, start_comp, num_comp, dt, solverChoice,
+                                   cell_data, cell_rhs, mf_u, mf_v, false, false);
+                NumericalDiffusion(tbx, 0, 1, dt, solverChoice,
+                                   rho_u, rho_u_rhs, mf_m, mf_v, false, true);
+                NumericalDiffusion(tby, 0, 1, dt, solverChoice,
+                                   rho_v, rho_v_rhs, mf_u, mf_m, true, false);
+                NumericalDiffusion(tbz, 0, 1, dt, solverChoice,
+                                   rho_w, rho_w_rhs, mf_u, mf_v, false, false);
+            }
+
+            continue;
         }
 
         // **************************************************************************
@@ -617,8 +622,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
             Array4<Real> diffflux_y = dflux_y->array(mfi);
             Array4<Real> diffflux_z = dflux_z->array(mfi);
 
-            Array4<Real> hfx_z = Hfx3->array(mfi);
-            Array4<Real> diss  = Diss->array(mfi);
+            Array4<AuxReal> hfx_z = Hfx3->array(mfi);
+            Array4<AuxReal> diss  = Diss->array(mfi);
 
             const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
 
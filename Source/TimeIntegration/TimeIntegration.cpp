@@ -55,27 +55,25 @@ void ERF::erf_advance(int level,
                            (solverChoice.pbl_type != PBLType::None) );
 
     const BoxArray& ba            = cons_old.boxArray();
-    const BoxArray& ba_z          = zvel_old.boxArray();
     const DistributionMapping& dm = cons_old.DistributionMap();
 
     MultiFab    S_prim  (ba  , dm, NUM_PRIM,          cons_old.nGrowVect());
     MultiFab  pi_stage  (ba  , dm,        1,          cons_old.nGrowVect());
-    MultiFab fast_coeffs(ba_z, dm,        5,          0);
     MultiFab* eddyDiffs = eddyDiffs_lev[level].get();
-    MultiFab* SmnSmn    = SmnSmn_lev[level].get();
+    AuxMultiFab* SmnSmn = SmnSmn_lev[level].get();
 
     // **************************************************************************************
     // Compute strain for use in slow RHS, Smagorinsky model, and MOST
     // **************************************************************************************
-    MultiFab* Tau11 = Tau11_lev[level].get();
-    MultiFab* Tau22 = Tau22_lev[level].get();
-    MultiFab* Tau33 = Tau33_lev[level].get();
-    MultiFab* Tau12 = Tau12_lev[level].get();
-    MultiFab* Tau13 = Tau13_lev[level].get();
-    MultiFab* Tau23 = Tau23_lev[level].get();
-    MultiFab* Tau21 = Tau21_lev[level].get();
-    MultiFab* Tau31 = Tau31_lev[level].get();
-    MultiFab* Tau32 = Tau32_lev[level].get();
+    AuxMultiFab* Tau11 = Tau11_lev[level].get();
+    AuxMultiFab* Tau22 = Tau22_lev[level].get();
+    AuxMultiFab* Tau33 = Tau33_lev[level].get();
+    AuxMultiFab* Tau12 = Tau12_lev[level].get();
+    AuxMultiFab* Tau13 = Tau13_lev[level].get();
+    AuxMultiFab* Tau23 = Tau23_lev[level].get();
+    AuxMultiFab* Tau21 = Tau21_lev[level].get();
+    AuxMultiFab* Tau31 = Tau31_lev[level].get();
+    AuxMultiFab* Tau32 = Tau32_lev[level].get();
     {
     BL_PROFILE("erf_advance_strain");
     if (l_use_diff) {
@@ -97,16 +95,16 @@ void ERF::erf_advance(int level,
             const Array4<const Real> & v = yvel_old.array(mfi);
             const Array4<const Real> & w = zvel_old.array(mfi);
 
-            Array4<Real> tau11 = Tau11->array(mfi);
-            Array4<Real> tau22 = Tau22->array(mfi);
-            Array4<Real> tau33 = Tau33->array(mfi);
-            Array4<Real> tau12 = Tau12->array(mfi);
-            Array4<Real> tau13 = Tau13->array(mfi);
-            Array4<Real> tau23 = Tau23->array(mfi);
+            Array4<AuxReal> tau11 = Tau11->array(mfi);
+            Array4<AuxReal> tau22 = Tau22->array(mfi);
+            Array4<AuxReal> tau33 = Tau33->array(mfi);
+            Array4<AuxReal> tau12 = Tau12->array(mfi);
+            Array4<AuxReal> tau13 = Tau13->array(mfi);
+            Array4<AuxReal> tau23 = Tau23->array(mfi);
 
-            Array4<Real> tau21  = l_use_terrain ? Tau21->array(mfi) : Array4<Real>{};
-            Array4<Real> tau31  = l_use_terrain ? Tau31->array(mfi) : Array4<Real>{};
-            Array4<Real> tau32  = l_use_terrain ? Tau32->array(mfi) : Array4<Real>{};
+            Array4<AuxReal> tau21  = l_use_terrain ? Tau21->array(mfi) : Array4<AuxReal>{};
+            Array4<AuxReal> tau31  = l_use_terrain ? Tau31->array(mfi) : Array4<AuxReal>{};
+            Array4<AuxReal> tau32  = l_use_terrain ? Tau32->array(mfi) : Array4<AuxReal>{};
             const Array4<const Real>& z_nd = l_use_terrain ? z_phys_nd[level]->const_array(mfi) : Array4<const Real>{};
 
             const Array4<const Real> mf_m = mapfac_m[level]->array(mfi);
@@ -161,10 +159,10 @@ void ERF::erf_advance(int level,
     } // profile
 
     // Additional SFS quantities, calculated once per timestep
-    MultiFab* Hfx1 = SFS_hfx1_lev[level].get();
-    MultiFab* Hfx2 = SFS_hfx2_lev[level].get();
-    MultiFab* Hfx3 = SFS_hfx3_lev[level].get();
-    MultiFab* Diss = SFS_diss_lev[level].get();
+    AuxMultiFab* Hfx1 = SFS_hfx1_lev[level].get();
+    AuxMultiFab* Hfx2 = SFS_hfx2_lev[level].get();
+    AuxMultiFab* Hfx3 = SFS_hfx3_lev[level].get();
+    AuxMultiFab* Diss = SFS_diss_lev[level].get();
 
     // *************************************************************************
     // Calculate cell-centered eddy viscosity & diffusivities
@@ -185,7 +183,7 @@ void ERF::erf_advance(int level,
                                   state_old[IntVar::cons],
                                   *eddyDiffs, *Hfx1, *Hfx2, *Hfx3, *Diss, // to be updated
                                   fine_geom, *mapfac_u[level], *mapfac_v[level],
-                                  solverChoice, m_most);
+                                  solverChoice, m_most, pbl_column_sum_lev[level].get());
     }
 
     // ***********************************************************************************************
@@ -206,6 +204,9 @@ void ERF::erf_advance(int level,
     MultiFab::Copy(xvel_new,xvel_old,0,0,1,xvel_old.nGrowVect());
     MultiFab::Copy(yvel_new,yvel_old,0,0,1,yvel_old.nGrowVect());
     MultiFab::Copy(zvel_new,zvel_old,0,0,1,zvel_old.nGrowVect());
+    StateBufferStats::add_copy(xvel_old,1,xvel_old.nGrowVect());
+    StateBufferStats::add_copy(yvel_old,1,yvel_old.nGrowVect());
+    StateBufferStats::add_copy(zvel_old,1,zvel_old.nGrowVect());
 
     bool fast_only          = false;
     bool vel_and_mom_synced = true;
@@ -265,6 +266,16 @@ void ERF::erf_advance(int level,
     mri_integrator.set_fast_rhs(fast_rhs_fun);
     mri_integrator.set_slow_fast_timestep_ratio(fixed_mri_dt_ratio > 0 ? fixed_mri_dt_ratio : dt_mri_ratio[level]);
     mri_integrator.set_no_substep(no_substep_fun);
+
+    // Choose the number of acoustic substeps in each stage from the stage data
+    if (fast_cfl > 0.) {
+        mri_integrator.set_stage_substeps([&](const Vector<MultiFab>& S_stage, const Real stage_dt)
+        {
+            return estFastSubsteps(level, S_stage, stage_dt);
+        });
+    } else {
+        mri_integrator.set_stage_substeps(nullptr);
+    }
     } // profile
 
     mri_integrator.advance(state_old, state_new, old_time, dt_advance);
@@ -0,0 +1,62 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 10
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+geometry.prob_extent =  256   256   256
+amr.n_cell           =   16    16    16
+amr.max_grid_size    =    8     8    16   # every box spans the vertical domain
+
+geometry.is_periodic = 1 1 0
+
+zhi.type = "SlipWall"
+
+# MOST BOUNDARY
+zlo.type                   = "Most"
+erf.most.average_policy    = 0       # POLICY FOR AVERAGING
+erf.most.z0                = 4.0     # SURFACE ROUGHNESS
+erf.most.zref              = 8.0     # QUERY DISTANCE (HEIGHT OR NORM LENGTH)
+
+# TIME STEP CONTROL
+erf.fixed_dt       = 0.1  # fixed time step depending on grid resolution
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval   = 1       # timesteps between computing mass
+erf.v              = 1       # verbosity in ERF.cpp
+amr.v              = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 0       # maximum level number allowed
+
+# CHECKPOINT FILES
+erf.check_file      = chk        # root name of checkpoint file
+erf.check_int       = -1         # number of timesteps between checkpoints
+
+# PLOTFILES
+erf.plot_file_1     = plt       # prefix of plotfile name
+erf.plot_int_1      = 10        # number of timesteps between plotfiles
+erf.plot_vars_1     = density rhoadv_0 x_velocity y_velocity z_velocity pressure temp theta
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 1.0
+erf.use_gravity = false
+
+erf.les_type = "None"
+erf.pbl_type = "MYNN2.5"
+
+# PROBLEM PARAMETERS
+prob.rho_0 = 1.0
+prob.A_0   = 1.0
+prob.T_0   = 300.0
+
+prob.U_0 = 10.0
+prob.V_0 = 0.0
+prob.W_0 = 0.0
+
+prob.U_0_Pert_Mag = 0.0
+prob.V_0_Pert_Mag = 0.0
+prob.W_0_Pert_Mag = 0.0